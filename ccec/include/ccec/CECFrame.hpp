@@ -52,12 +52,17 @@ class CECFrame {
         void hexDump(int level=6) const;
         uint8_t & operator[](size_t i);
 
+        /*
+         * A CEC message on the wire is at most 16 blocks: header, opcode
+         * and up to 14 operand bytes. Keeping the frame this small (17 bytes)
+         * lets queued frames and temporaries share a cache line.
+         */
         enum {
-            MAX_LENGTH = 128,
+            MAX_LENGTH = 16,
         };
     private:
         uint8_t buf_[MAX_LENGTH];
-        size_t len_;
+        uint8_t len_;
 };
 
 CCEC_END_NAMESPACE
@@ -0,0 +1,103 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_FRAME_VIEW_
+#define HDMI_CCEC_FRAME_VIEW_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdexcept>
+#include "CCEC.hpp"
+#include "CECFrame.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+/**
+ * @brief Non-owning, read-only window onto the bytes of a CECFrame.
+ *
+ * A view is a pointer, a length and an offset. It is used on the decode path so that
+ * Header, OpCode, the operands and the messages can read a received frame in place
+ * instead of copying operand bytes into a sub frame first.
+ *
+ * A CECFrame converts implicitly to a view of all of its bytes, so every constructor
+ * that takes a view also accepts a CECFrame. The view must not outlive the frame it
+ * was taken from.
+ * @ingroup HDMI_CEC_MSG_N_FRAME_CLASSES
+ */
+class CECFrameView {
+    public:
+        CECFrameView(const uint8_t *buf = NULL, size_t len = 0, size_t offset = 0)
+        : buf_(buf), len_((uint8_t)(len > CECFrame::MAX_LENGTH ? CECFrame::MAX_LENGTH : len)), offset_(0) {
+            offset_ = (uint8_t)(offset > len_ ? len_ : offset);
+        }
+
+        CECFrameView(const CECFrame &frame, size_t offset = 0)
+        : buf_(frame.getBuffer()), len_((uint8_t)frame.length()), offset_(0) {
+            offset_ = (uint8_t)(offset > len_ ? len_ : offset);
+        }
+
+        /* View of the bytes from start onwards, relative to this view */
+        CECFrameView subView(size_t start) const {
+            return CECFrameView(buf_, len_, offset_ + start);
+        }
+
+        void getBuffer(const uint8_t **buf, size_t *len) const {
+            *buf = buf_ + offset_;
+            *len = length();
+        }
+
+        const uint8_t * getBuffer(void) const {
+            return buf_ + offset_;
+        }
+
+        uint8_t at(size_t i) const {
+            if (i >= length()) {
+                throw std::out_of_range("Frame reads beyond maximum");
+            }
+            return buf_[offset_ + i];
+        }
+
+        size_t length(void) const {
+            return len_ - offset_;
+        }
+
+    private:
+        const uint8_t *buf_;
+        uint8_t len_;
+        uint8_t offset_;
+};
+
+CCEC_END_NAMESPACE
+
+#endif
+
+
+
+/** @} */
+/** @} */
@@ -39,10 +39,12 @@
 #include "ccec/FrameListener.hpp"
 #include "ccec/Operands.hpp"
 #include "ccec/Driver.hpp"
+#include "ccec/TxCompletion.hpp"
 #include "ccec/LibCCEC.hpp"
 #include "ccec/Exception.hpp"
 
 using CCEC_OSAL::Mutex;
+using CCEC_OSAL::RecursiveMutex;
 
 CCEC_BEGIN_NAMESPACE
 class Bus;
@@ -70,11 +72,19 @@ public:
 	void sendTo(const LogicalAddress &to, const CECFrame &frame, int timeout, const Throw_e &doThrow);
 	void send(const CECFrame &frame, int timeout = 0);
 	void sendTo(const LogicalAddress &to, const CECFrame &frame, int timeout = 0);
-	void sendToAsync(const LogicalAddress &to, const CECFrame &frame);
+	TxCompletion sendToAsync(const LogicalAddress &to, const CECFrame &frame, TxPriority priority = TX_PRIORITY_RESPONSE,
+	                         TxCompletionListener *listener = NULL, const TxRetryPolicy &policy = TxRetryPolicy());
 	void poll(const LogicalAddress &from, const Throw_e &doThrow);
 	void ping(const LogicalAddress &from, const LogicalAddress &to, const Throw_e &doThrow);
+
+	/* Non-throwing variants of the calls above, eg for a bus scan where most pings are NACKed */
+	SendResult trySend(const CECFrame &frame, int timeout = 0) noexcept;
+	SendResult trySendTo(const LogicalAddress &to, const CECFrame &frame, int timeout = 0) noexcept;
+	SendResult tryPoll(const LogicalAddress &from) noexcept;
+	SendResult tryPing(const LogicalAddress &from, const LogicalAddress &to) noexcept;
 		
-	void sendAsync(const CECFrame &frame);
+	TxCompletion sendAsync(const CECFrame &frame, TxPriority priority = TX_PRIORITY_RESPONSE, TxCompletionListener *listener = NULL,
+	                       const TxRetryPolicy &policy = TxRetryPolicy());
 
 	const LogicalAddress & getSource(void) {
 		return source;
@@ -111,7 +121,8 @@ private:
     DefaultFilter busFrameFilter;
     DefaultFrameListener busFrameListener;
 	std::list<FrameListener *> frameListeners;
-	Mutex mutex;
+	/* Held while the listeners are notified, which may add or remove listeners */
+	RecursiveMutex mutex;
 };
 
 CCEC_END_NAMESPACE
@@ -42,6 +42,60 @@ using CCEC_OSAL::Mutex;
 
 CCEC_BEGIN_NAMESPACE
 
+/*
+ * Outcome of a transmit, returned by the non-throwing send, poll and ping calls
+ * (Driver::tryWrite, Bus::trySend, Connection::trySend, ...).
+ */
+typedef enum {
+	SEND_ACKED = 0,      //On the bus and destination device ack'd (always the case for broadcasts)
+	SEND_NACKED,         //On the bus but no destination device.
+	SEND_BUS_ERROR,      //Not getting on the bus, or the driver failed.
+	SEND_TIMED_OUT,      //Retried until the timeout lapsed without an ack.
+	SEND_INVALID_STATE,  //Driver is not opened or the bus is not started.
+	SEND_SUPERSEDED,     //Replaced in the transmit queue by a newer frame before it was sent.
+} SendResult;
+
+/*
+ * Transmit priority classes of the Bus writer, highest first. Frames of a lower
+ * class that have waited too long are sent ahead of higher ones, so no class
+ * starves.
+ */
+typedef enum {
+	TX_PRIORITY_INTERACTIVE = 0,  //Remote control forwarding, eg <User Control Pressed>
+	TX_PRIORITY_RESPONSE,         //Replies to requests, eg <Report Power Status>
+	TX_PRIORITY_ANNOUNCEMENT,     //State announcements, eg <Active Source> on wake
+	TX_PRIORITY_BACKGROUND,       //Discovery, eg device scans and <Give OSD Name>
+	TX_PRIORITY_MAX,
+} TxPriority;
+
+/*
+ * Time frames of one priority class spent queued before the writer took them,
+ * and how many queued frames were replaced by newer ones (see Bus coalescing).
+ */
+typedef struct {
+	uint32_t frames;
+	uint64_t totalWaitUs;
+	uint64_t maxWaitUs;
+	uint32_t superseded;
+} TxQueueStats;
+
+/*
+ * Frames received from the HAL, how many were dropped because the reader was
+ * behind, and the time from the HAL callback to the start of their dispatch to
+ * the FrameListeners.
+ */
+typedef struct {
+	uint32_t frames;
+	uint32_t dropped;
+	uint64_t totalLatencyUs;
+	uint64_t maxLatencyUs;
+} RxStats;
+
+const char *GetSendResultName(SendResult result);
+
+/* Throws the exception the throwing API raises for result; returns on SEND_ACKED */
+void CheckSendResult(SendResult result) noexcept(false);
+
 class Driver {
 public:
 	static Driver &getInstance(void);
@@ -58,6 +112,10 @@ public:
 	virtual void  open(void) noexcept(false) = 0;
 	virtual void  close(void) noexcept(false) = 0;
 	virtual void  read(CECFrame &frame) noexcept(false) = 0; 
+	/* Like read(), without the copy: the frame stays valid until releaseFrame() */
+	virtual const CECFrame & acquireFrame(void) noexcept(false) = 0;
+	virtual void  releaseFrame(void) noexcept = 0;
+	virtual void  getRxStats(RxStats &stats) = 0;
 	virtual void  write(const CECFrame &frame) noexcept(false) = 0;
 	virtual void  writeAsync(const CECFrame &frame) noexcept(false) = 0;
 	virtual void  removeLogicalAddress(const LogicalAddress &source)  = 0;
@@ -67,6 +125,8 @@ public:
 	virtual void getPhysicalAddress(unsigned int *physicalAddress) = 0;
 	virtual bool isValidLogicalAddress(const LogicalAddress &source) const = 0;
 	virtual void poll(const LogicalAddress &from, const LogicalAddress &to) noexcept(false) = 0;
+	virtual SendResult tryWrite(const CECFrame &frame) noexcept = 0;
+	virtual SendResult tryPoll(const LogicalAddress &from, const LogicalAddress &to) noexcept = 0;
 	virtual void printFrameDetails(const CECFrame &frame) noexcept(false) = 0;
 
 	virtual ~Driver(void) {};
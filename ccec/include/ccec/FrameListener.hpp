@@ -40,6 +40,8 @@ class FrameListener
 {
 public:
 	virtual void notify(const CECFrame &) const = 0;
+	/* Bus and Connection only call notify() for frames the listener is interested in. Default: all frames */
+	virtual bool isInterested(const CECFrame &) const { return true; }
 	virtual ~FrameListener(void) {}
 };
 
@@ -49,13 +49,13 @@ public:
         print();
     };
 
-	Header(const CECFrame &frame, size_t startPos = 0) {
+	Header(const CECFrameView &frame, size_t startPos = 0) {
         from = LogicalAddress((frame.at(startPos) & 0xF0) >> 4);
         to   = LogicalAddress((frame.at(startPos) & 0x0F) >> 0);
 	}
 
 	CECFrame &serialize(CECFrame &frame) const {
-		CCEC_LOG( LOG_DEBUG, "Serialing header  %s   %s \n",from.toString().c_str(),to.toString().c_str());
+		CCEC_LOG( LOG_DEBUG, "Serialing header  %s   %s \n",from.getName(),to.getName());
         /* serialize to same byte */
         to.serialize(frame);
         uint8_t &byte = frame[frame.length() - 1];
@@ -67,8 +67,8 @@ public:
 	virtual ~Header(void) {};
 
     void print(void) const {
-        CCEC_LOG( LOG_DEBUG, "Header : From : %s \n", from.toString().c_str());
-        CCEC_LOG( LOG_DEBUG, "Header : to   : %s \n", to.toString().c_str());
+        CCEC_LOG( LOG_DEBUG, "Header : From : %s \n", from.getName());
+        CCEC_LOG( LOG_DEBUG, "Header : to   : %s \n", to.getName());
     }
 
 
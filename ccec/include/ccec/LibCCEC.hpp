@@ -33,6 +33,7 @@
 #include "osal/Mutex.hpp"
 #include "ccec/CCEC.hpp"
 #include "Operands.hpp"
+#include "Driver.hpp"
 using CCEC_OSAL::Mutex;
 
 CCEC_BEGIN_NAMESPACE
@@ -49,6 +50,9 @@ public:
 	int getLogicalAddress(int devType);
 	void getPhysicalAddress(unsigned int *physicalAddress);
 	int addLogicalAddress(const LogicalAddress &source);
+	void getTxQueueStats(TxPriority priority, TxQueueStats &stats);
+	void setTxCoalescing(bool enable);
+	void getRxStats(RxStats &stats);
 
 private:
 //	int logicalAddresses;
@@ -30,11 +30,30 @@
 #define HDMI_CCEC_MESSAGE_DECODER_HPP_
 
 #include "CCEC.hpp"
+#include "DataBlock.hpp"
 
 CCEC_BEGIN_NAMESPACE
 
 class MessageProcessor;
 class CECFrame;
+class CECFrameView;
+class Header;
+
+/**
+ * @brief Application supplied handler for an opcode, typically a vendor command
+ * that the library does not decode itself.
+ *
+ * Registered with MessageDecoder::registerHandler(). The handler receives the
+ * operand bytes (everything after the opcode) undecoded, and is called from the
+ * thread that runs the decoder.
+ * @ingroup HDMI_CEC_MSG_N_FRAME_CLASSES
+ */
+class OpCodeHandler
+{
+public:
+	virtual void process(const CECFrameView &operands, const Header &header) = 0;
+	virtual ~OpCodeHandler(void) {}
+};
 
 /**
  * @brief When receiving the message, the raw bytes arrived in a CECFrame are converted to the
@@ -45,9 +64,37 @@ class CECFrame;
 class MessageDecoder
 {
 public:
+	enum Status {
+		DECODE_OK,                  /* Handed to the processor or a registered handler */
+		DECODE_IGNORED,             /* Processor is not interested in the opcode */
+		DECODE_UNHANDLED,           /* No built-in decoding and no handler for the opcode */
+		DECODE_INVALID_LENGTH,      /* Empty frame, or fewer operands than the opcode requires */
+		DECODE_INVALID_ADDRESSING,  /* Directed-only opcode broadcast, or vice versa */
+		DECODE_PROCESS_ERROR,       /* Processor or handler threw while processing the message */
+		DECODE_INVALID_OPERAND,     /* An operand value is malformed or out of range */
+		DECODE_STATUS_MAX,
+	};
+
 	MessageDecoder(MessageProcessor & processor) : processor(processor){};
 	void decode(const CECFrame &in);
 
+	/*
+	 * Same as decode(), but never throws and reports what happened to the frame.
+	 * Rejected frames are counted; a summary of them is logged from the decoding
+	 * thread at most once every 30 seconds, not per frame.
+	 */
+	Status tryDecode(const CECFrame &in) noexcept;
+
+	/* Number of frames that ended with status, since the process started */
+	static size_t getCount(Status status);
+
+	/*
+	 * Routes an opcode to handler in every decoder of the process, in place of
+	 * the built-in decoding (if any). Passing NULL restores the default.
+	 * The handler must stay valid until it is unregistered.
+	 */
+	static void registerHandler(Op_t opCode, OpCodeHandler *handler);
+
 private:
 	MessageProcessor &processor;
 };
@@ -34,9 +34,56 @@
 #include "DataBlock.hpp"
 #include "OpCode.hpp"
 #include "Header.hpp"
+#include "Messages.hpp"
 
 CCEC_BEGIN_NAMESPACE
 
+/**
+ * @brief Compile-time description of a message that has no operands.
+ *
+ * Only the messages listed below are specialized, so encoding any other message
+ * through MessageEncoder::encode<M>() fails to compile.
+ */
+template <class M> struct ConstantMessage;
+
+#define CCEC_CONSTANT_MESSAGE(Message_, opCode_) \
+    template <> struct ConstantMessage<Message_> { \
+        enum { \
+            OPCODE = opCode_, \
+            LENGTH = (opCode_ == POLLING) ? 1 : 2, \
+        }; \
+    }
+
+CCEC_CONSTANT_MESSAGE(ImageViewOn,              IMAGE_VIEW_ON);
+CCEC_CONSTANT_MESSAGE(TextViewOn,               TEXT_VIEW_ON);
+CCEC_CONSTANT_MESSAGE(RequestActiveSource,      REQUEST_ACTIVE_SOURCE);
+CCEC_CONSTANT_MESSAGE(Standby,                  STANDBY);
+CCEC_CONSTANT_MESSAGE(GetCECVersion,            GET_CEC_VERSION);
+CCEC_CONSTANT_MESSAGE(GetMenuLanguage,          GET_MENU_LANGUAGE);
+CCEC_CONSTANT_MESSAGE(GiveOSDName,              GIVE_OSD_NAME);
+CCEC_CONSTANT_MESSAGE(GivePhysicalAddress,      GIVE_PHYSICAL_ADDRESS);
+CCEC_CONSTANT_MESSAGE(GiveDeviceVendorID,       GIVE_DEVICE_VENDOR_ID);
+CCEC_CONSTANT_MESSAGE(GiveDevicePowerStatus,    GIVE_DEVICE_POWER_STATUS);
+CCEC_CONSTANT_MESSAGE(Abort,                    ABORT);
+CCEC_CONSTANT_MESSAGE(GiveAudioStatus,          GIVE_AUDIO_STATUS);
+CCEC_CONSTANT_MESSAGE(UserControlReleased,      USER_CONTROL_RELEASED);
+CCEC_CONSTANT_MESSAGE(Polling,                  POLLING);
+CCEC_CONSTANT_MESSAGE(RequestArcInitiation,     REQUEST_ARC_INITIATION);
+CCEC_CONSTANT_MESSAGE(ReportArcInitiation,      REPORT_ARC_INITIATED);
+CCEC_CONSTANT_MESSAGE(RequestArcTermination,    REQUEST_ARC_TERMINATION);
+CCEC_CONSTANT_MESSAGE(ReportArcTermination,     REPORT_ARC_TERMINATED);
+CCEC_CONSTANT_MESSAGE(InitiateArc,              INITIATE_ARC);
+CCEC_CONSTANT_MESSAGE(TerminateArc,             TERMINATE_ARC);
+CCEC_CONSTANT_MESSAGE(GiveFeatures,             GIVE_FEATURES);
+
+#undef CCEC_CONSTANT_MESSAGE
+
+/* Header block: initiator in the high nibble, destination in the low nibble */
+constexpr uint8_t HeaderByte(int from, int to)
+{
+    return (uint8_t)(((from & 0x0F) << 4) | (to & 0x0F));
+}
+
 /**
  * @brief High-level messages are encoded by the MessageEncoder into raw bytes and placed in a CECFrame.
  *
@@ -74,6 +121,35 @@ public:
         CECFrame out;
         return encode(m, out);
     }
+
+    /*
+     * Messages without operands. The frame is at most a header byte and an
+     * opcode byte, so it is stored directly instead of serializing the header,
+     * opcode and message through DataBlock. The bytes are identical to the
+     * ones produced by encode(Header(from, to), M()).
+     */
+	template <class M>
+	static CECFrame & encode(const LogicalAddress &from, const LogicalAddress &to, CECFrame &out)
+    {
+        const uint8_t bytes[2] = {HeaderByte(from.toInt(), to.toInt()), (uint8_t)ConstantMessage<M>::OPCODE};
+        out.append(bytes, ConstantMessage<M>::LENGTH);
+        return out;
+    }
+
+	template <class M>
+	static CECFrame encode(const LogicalAddress &from, const LogicalAddress &to)
+    {
+        CECFrame out;
+        return encode<M>(from, to, out);
+    }
+
+    /* Same, with the addresses known at compile time: the bytes are a constant */
+	template <class M, int From, int To>
+	static CECFrame encode(void)
+    {
+        static constexpr uint8_t bytes[2] = {HeaderByte(From, To), (uint8_t)ConstantMessage<M>::OPCODE};
+        return CECFrame(bytes, ConstantMessage<M>::LENGTH);
+    }
 };
 
 CCEC_END_NAMESPACE
@@ -53,12 +53,26 @@ CCEC_BEGIN_NAMESPACE
  *        ActiveSource(PhysicalAddress(phy0, phy1, phy2, phy3)));
  * Connection(LogicalAddress(TUNER_1)).send(frame);
  * @endcode
+ * @n @n
+ * A processor that only handles a few messages should pass the set of opcodes it handles
+ * to the constructor. MessageDecoder then skips the decoding and the process() call for every
+ * other opcode, and a FrameListener can use isInterested() to drop such frames before they are
+ * dispatched at all. Polling messages carry no opcode and are always delivered.
  * @ingroup HDMI_CEC_MSG_N_FRAME_CLASSES
  */
 class MessageProcessor
 {
 public:
-	MessageProcessor(void) {}
+	MessageProcessor(void) { interest.set(); }
+	MessageProcessor(const OpCodeSet &interest) : interest(interest) {}
+
+	bool isInterested(Op_t opCode) const {
+		return (opCode >= interest.size()) || interest.test(opCode);
+	}
+
+	bool isInterested(const CECFrame &frame) const {
+		return (frame.length() < 2) || interest.test(frame.at(1));
+	}
 
 	virtual void process (const ActiveSource &msg, const Header &header)   				{header.print();msg.print();}
 	virtual void process (const InActiveSource &msg, const Header &header) 				{header.print();msg.print();}
@@ -100,7 +114,8 @@ public:
 	virtual void process (const ReportCurrentLatency &msg, const Header &header)               	 {header.print();msg.print();}
 	virtual ~MessageProcessor(void) {}
 
-private:
+protected:
+	OpCodeSet interest;
 };
 
 CCEC_END_NAMESPACE
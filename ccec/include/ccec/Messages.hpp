@@ -93,7 +93,7 @@ public:
 	ActiveSource(const PhysicalAddress &physicalAddress) : physicalAddress(physicalAddress) {
     }
 
-	ActiveSource(const CECFrame &frame, int startPos = 0) 
+	ActiveSource(const CECFrameView &frame, int startPos = 0) 
     : physicalAddress(frame, startPos)
     {
     }
@@ -129,7 +129,7 @@ public:
 
 	InActiveSource(const PhysicalAddress &physicalAddress) : physicalAddress(physicalAddress) {}
 
-	InActiveSource(const CECFrame &frame, int startPos = 0) 
+	InActiveSource(const CECFrameView &frame, int startPos = 0) 
     : physicalAddress(frame, startPos)
     {
     }
@@ -171,7 +171,7 @@ public:
 
     CECVersion(const Version &version) : version(version) {}
 
-    CECVersion(const CECFrame &frame, int startPos = 0)
+    CECVersion(const CECFrameView &frame, int startPos = 0)
     : version(frame, startPos)
     {
     }
@@ -195,7 +195,7 @@ public:
 
     SetMenuLanguage(const Language &language) : language(language) {};
 
-    SetMenuLanguage(const CECFrame &frame, int startPos = 0)
+    SetMenuLanguage(const CECFrameView &frame, int startPos = 0)
     : language(frame, startPos)
     {
     }
@@ -230,7 +230,7 @@ public:
 
     SetOSDName(const OSDName &osdName) : osdName(osdName) {};
 
-    SetOSDName(const CECFrame &frame, int startPos = 0)
+    SetOSDName(const CECFrameView &frame, int startPos = 0)
     : osdName(frame, startPos)
     {
     }
@@ -253,7 +253,7 @@ public:
 
     SetOSDString(const OSDString &osdString) : osdString(osdString) {};
 
-    SetOSDString(const CECFrame &frame, int startPos = 0)
+    SetOSDString(const CECFrameView &frame, int startPos = 0)
     : osdString(frame, startPos)
     {
     }
@@ -284,7 +284,7 @@ public:
     : physicalAddress(physicalAddress), deviceType(deviceType) {
     }
 
-    ReportPhysicalAddress(const CECFrame &frame, int startPos = 0)
+    ReportPhysicalAddress(const CECFrameView &frame, int startPos = 0)
     : physicalAddress(frame, startPos), deviceType(frame, startPos + PhysicalAddress::MAX_LEN)
     {
     }
@@ -315,7 +315,7 @@ public:
 
     DeviceVendorID(const VendorID &vendorId) : vendorId(vendorId) {}
 
-    DeviceVendorID(const CECFrame &frame, int startPos = 0)
+    DeviceVendorID(const CECFrameView &frame, int startPos = 0)
     : vendorId(frame, startPos)
     {
     }
@@ -344,7 +344,7 @@ public:
 
     ReportPowerStatus(const PowerStatus &status) : status(status) {}
 
-    ReportPowerStatus(const CECFrame &frame, int startPos = 0)
+    ReportPowerStatus(const CECFrameView &frame, int startPos = 0)
     : status(frame, startPos)
     {
     }
@@ -373,7 +373,7 @@ public:
 
     FeatureAbort(const OpCode &feature, const AbortReason &reason) : feature(feature), reason(reason) {}
 
-    FeatureAbort(const CECFrame &frame, int startPos = 0)
+    FeatureAbort(const CECFrameView &frame, int startPos = 0)
     : feature(frame, startPos), reason(frame, startPos + OpCode::MAX_LEN)
     {
     }
@@ -398,7 +398,7 @@ public:
 
     RoutingChange(const PhysicalAddress &from, const PhysicalAddress &to) : from(from), to(to) {}
 
-    RoutingChange(const CECFrame &frame, int startPos = 0)
+    RoutingChange(const CECFrameView &frame, int startPos = 0)
     : from(frame, startPos), to(frame, startPos + PhysicalAddress::MAX_LEN)
     {
     }
@@ -423,7 +423,7 @@ public:
 
     RoutingInformation(const PhysicalAddress &toSink) : toSink(toSink) {}
 
-    RoutingInformation(const CECFrame &frame, int startPos = 0)
+    RoutingInformation(const CECFrameView &frame, int startPos = 0)
     : toSink(frame, startPos)
     {
     }
@@ -447,7 +447,7 @@ public:
 
     SetStreamPath(const PhysicalAddress &toSink) : toSink(toSink) {}
 
-    SetStreamPath(const CECFrame &frame, int startPos = 0)
+    SetStreamPath(const CECFrameView &frame, int startPos = 0)
     : toSink(frame, startPos)
     {
     }
@@ -480,7 +480,7 @@ public:
 	    }
        }
 	 /* called by the messaged_decoder */
-     RequestShortAudioDescriptor(const CECFrame &frame, int startPos = 0)
+     RequestShortAudioDescriptor(const CECFrameView &frame, int startPos = 0)
      {
 	uint8_t len = frame.length();
         numberofdescriptor = len > 4 ? 4:len;
@@ -533,7 +533,7 @@ public:
 	        }
 	      }
 	       /* called by the messaged_decoder */
-             ReportShortAudioDescriptor(const CECFrame &frame, int startPos = 0)
+             ReportShortAudioDescriptor(const CECFrameView &frame, int startPos = 0)
             {
                numberofdescriptor = (frame.length())/3;
                for (uint8_t i=0; i< numberofdescriptor ;i++)
@@ -568,12 +568,10 @@ public:
     Op_t opCode(void) const {return SYSTEM_AUDIO_MODE_REQUEST;}
 	SystemAudioModeRequest(const PhysicalAddress &physicaladdress = {0xf,0xf,0xf,0xf} ): physicaladdress(physicaladdress) {}
 	 /* called by the messaged_decoder */
-	SystemAudioModeRequest(const CECFrame &frame, int startPos = 0):physicaladdress(frame, startPos)
+	SystemAudioModeRequest(const CECFrameView &frame, int startPos = 0):physicaladdress((uint8_t) 0xf,(uint8_t) 0xf,(uint8_t)0xf,(uint8_t)0xf)
         {
-           if (frame.length() == 0 )
-	   {
-              physicaladdress= PhysicalAddress((uint8_t) 0xf,(uint8_t) 0xf,(uint8_t)0xf,(uint8_t)0xf);
-	   }
+           /* The [Physical Address] is optional; leave it at F.F.F.F when absent */
+           PhysicalAddress::parse(frame, startPos, physicaladdress);
         }
       CECFrame &serialize(CECFrame &frame) const {
         if ( (physicaladdress.getByteValue(3) == 0xF) && (physicaladdress.getByteValue(2) == 0xF) && (physicaladdress.getByteValue(1) == 0xF) &&  (physicaladdress.getByteValue(0) == 0xF))
@@ -595,7 +593,7 @@ public:
 
 	SetSystemAudioMode( const SystemAudioStatus &status ) : status(status) { }
 
-	SetSystemAudioMode(const CECFrame &frame, int startPos = 0) : status(frame, startPos)
+	SetSystemAudioMode(const CECFrameView &frame, int startPos = 0) : status(frame, startPos)
        {
        }
 	CECFrame &serialize(CECFrame &frame) const {
@@ -616,7 +614,7 @@ public:
     Op_t opCode(void) const {return REPORT_AUDIO_STATUS;}
 
     ReportAudioStatus( const AudioStatus &status ) : status(status) { }
-    ReportAudioStatus(const CECFrame &frame, int startPos = 0):status(frame, startPos)
+    ReportAudioStatus(const CECFrameView &frame, int startPos = 0):status(frame, startPos)
     {
     }
     CECFrame &serialize(CECFrame &frame) const {
@@ -631,7 +629,7 @@ public:
     Op_t opCode(void) const {return USER_CONTROL_PRESSED;}
 
 	UserControlPressed( const UICommand &command ) : uiCommand(command) { }
-    UserControlPressed(const CECFrame &frame, int startPos = 0):uiCommand(frame, startPos)
+    UserControlPressed(const CECFrameView &frame, int startPos = 0):uiCommand(frame, startPos)
 	{
 	}
 
@@ -712,7 +710,7 @@ class ReportFeatures : public DataBlock
         }
 
         /* called by the messaged_decoder */
-        ReportFeatures(const CECFrame &frame, int startPos = 0) : version(frame, startPos = 0) , allDeviceTypes(frame, startPos+Version::MAX_LEN) {
+        ReportFeatures(const CECFrameView &frame, int startPos = 0) : version(frame, startPos = 0) , allDeviceTypes(frame, startPos+Version::MAX_LEN) {
                 const uint8_t *buf = 0;
                 size_t frameLen = 0, rc_len = 1, features_len = 1;
 
@@ -844,12 +842,9 @@ class RequestCurrentLatency : public DataBlock
     Op_t opCode(void) const {return REQUEST_CURRENT_LATENCY;}
         RequestCurrentLatency(const PhysicalAddress &physicaladdress = {0xf,0xf,0xf,0xf} ): physicaladdress(physicaladdress) {}
          /* called by the messaged_decoder */
-        RequestCurrentLatency(const CECFrame &frame, int startPos = 0):physicaladdress(frame, startPos)
+        RequestCurrentLatency(const CECFrameView &frame, int startPos = 0):physicaladdress((uint8_t) 0xf,(uint8_t) 0xf,(uint8_t)0xf,(uint8_t)0xf)
         {
-           if (frame.length() == 0 )
-           {
-              physicaladdress= PhysicalAddress((uint8_t) 0xf,(uint8_t) 0xf,(uint8_t)0xf,(uint8_t)0xf);
-           }
+           PhysicalAddress::parse(frame, startPos, physicaladdress);
         }
         CECFrame &serialize(CECFrame &frame) const {
           if ( (physicaladdress.getByteValue(3) == 0xF) && (physicaladdress.getByteValue(2) == 0xF) && (physicaladdress.getByteValue(1) == 0xF) &&  (physicaladdress.getByteValue(0) == 0xF)) {
@@ -881,7 +876,7 @@ class ReportCurrentLatency : public DataBlock
             }
 	}
          /* called by the messaged_decoder */
-        ReportCurrentLatency(const CECFrame &frame, int startPos = 0) :physicaladdress(frame, startPos) {
+        ReportCurrentLatency(const CECFrameView &frame, int startPos = 0) :physicaladdress(frame, startPos) {
             uint8_t frame_len = frame.length();
             frame_len = frame_len > 5 ? 5 : frame_len ;
             latencyInfo.push_back(LatencyInfo(frame,startPos + 2, frame_len - 2));
@@ -30,9 +30,11 @@
 #define HDMI_CCEC_OPCODE_HPP_
 
 #include <iostream>
+#include <bitset>
 
 #include "CCEC.hpp"
 #include "ccec/CECFrame.hpp"
+#include "ccec/CECFrameView.hpp"
 #include "Assert.hpp"
 
 #include "DataBlock.hpp"
@@ -124,6 +126,42 @@ enum
 	UNKNOWN                         = 0xFFFF
 };
 
+/* Addressing allowed for an opcode */
+enum
+{
+	OPCODE_DIRECTED                 = 0x01,
+	OPCODE_BROADCAST                = 0x02,
+};
+
+/**
+ * @brief Static description of an opcode, looked up in constant time.
+ *
+ * Operand lengths count the bytes after the opcode. response is the opcode
+ * a follower is expected to reply with, or UNKNOWN if the message has no reply.
+ * @ingroup HDMI_CEC_MSG_N_FRAME_CLASSES
+ */
+struct OpCodeInfo
+{
+	const char *name;
+	uint8_t minOperandLength;
+	uint8_t maxOperandLength;
+	uint8_t addressing;
+	uint16_t response;
+};
+
+const OpCodeInfo & GetOpCodeInfo(Op_t op);
+
+/* One bit per opcode */
+typedef std::bitset<256> OpCodeSet;
+
+/*
+ * Checks a received frame against the opcode table before anything is decoded:
+ * too few operand bytes, or directed/broadcast addressing the opcode does not
+ * allow, make the frame invalid. Extra operand bytes are allowed, as required
+ * for forward compatibility. A polling frame is always valid.
+ */
+bool IsValidFrame(const CECFrameView &frame);
+
 class OpCode : public DataBlock 
 {
 public:
@@ -132,7 +170,7 @@ public:
     };
 
     OpCode(Op_t opCode) : opCode_(opCode) {};
-	OpCode(const CECFrame &frame, int startPos) : opCode_(frame.at(startPos)) {
+	OpCode(const CECFrameView &frame, int startPos) : opCode_(frame.at(startPos)) {
     }
 	CECFrame &serialize(CECFrame &frame) const {
         if (opCode_ != POLLING) {
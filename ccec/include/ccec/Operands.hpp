@@ -35,6 +35,7 @@
 #include <vector>
 #include <bitset>
 #include <string>
+#include <stdexcept>
 
 #include <sstream>
 
@@ -43,10 +44,74 @@
 #include "Operand.hpp"
 #include "Util.hpp"
 #include "ccec/CECFrame.hpp"
+#include "ccec/CECFrameView.hpp"
 #include "ccec/Exception.hpp"
 
 CCEC_BEGIN_NAMESPACE
 
+/**
+ * @brief Fixed capacity byte array holding the bytes of an operand.
+ *
+ * No operand is longer than a CEC frame, so the bytes are stored inline and
+ * building, copying or comparing an operand never touches the heap.
+ * @ingroup HDMI_CEC_MSG_N_FRAME_CLASSES
+ */
+class CECByteArray
+{
+public:
+    enum {
+        CAPACITY = CECFrame::MAX_LENGTH,
+    };
+
+    typedef uint8_t * iterator;
+    typedef const uint8_t * const_iterator;
+
+    CECByteArray(void) : len_(0) {}
+    CECByteArray(size_t count, uint8_t val) : len_(0) {
+        while (count--) {
+            push_back(val);
+        }
+    }
+
+    size_t size(void) const { return len_; }
+
+    iterator begin(void) { return buf_; }
+    iterator end(void) { return buf_ + len_; }
+    const_iterator begin(void) const { return buf_; }
+    const_iterator end(void) const { return buf_ + len_; }
+
+    uint8_t & operator[](size_t i) { return buf_[i]; }
+    const uint8_t & operator[](size_t i) const { return buf_[i]; }
+
+    void clear(void) { len_ = 0; }
+
+    void push_back(uint8_t byte) {
+        if (len_ >= CAPACITY) {
+            throw std::out_of_range("Operand grows beyond maximum");
+        }
+        buf_[len_++] = byte;
+    }
+
+    void insert(iterator pos, const uint8_t *first, const uint8_t *last) {
+        size_t count = last - first;
+        size_t at = pos - buf_;
+        if (count > (size_t)(CAPACITY - len_)) {
+            throw std::out_of_range("Operand grows beyond maximum");
+        }
+        memmove(buf_ + at + count, buf_ + at, len_ - at);
+        memcpy(buf_ + at, first, count);
+        len_ += count;
+    }
+
+    bool operator == (const CECByteArray &in) const {
+        return (len_ == in.len_) && (memcmp(buf_, in.buf_, len_) == 0);
+    }
+
+private:
+    uint8_t buf_[CAPACITY];
+    uint8_t len_;
+};
+
 class CECBytes : public Operand
 {
 protected:
@@ -63,7 +128,7 @@ protected:
 		return (str.size() && (str.size() <= getMaxLen()));
 	}
 
-	CECBytes(const CECFrame &frame, size_t startPos, size_t len) {
+	CECBytes(const CECFrameView &frame, size_t startPos, size_t len) {
     	/*
     	 * For HDMI CEC definition, the [OSD Name] and [OSD STring] are always the one
     	 * and only one operands in the message. It is not clear if these strings are
@@ -74,6 +139,7 @@ protected:
         size_t frameLen = 0;
         frame.getBuffer(&buf, &frameLen);
         str.clear();
+        if (startPos > frameLen) startPos = frameLen;
         len = ((startPos + len) > frameLen) ? frameLen - startPos : len;
         str.insert(str.begin(), buf + startPos, buf + startPos + len);
         if (!validate())
@@ -106,8 +172,57 @@ public:
 		return this->str == in.str;
 	}
 
+    /*
+     * Non-throwing counterparts of the decoding constructors, for use on the
+     * decode path. The operand must start within the frame, and len is clamped
+     * to the bytes left in it. The value is built aside and checked with T's
+     * validate() (once construction is over, so getMaxLen() is T's own) before
+     * it is stored. out is left untouched and false is returned if the frame
+     * holds no bytes for the operand at startPos or T rejects them.
+     *
+     * eg: PhysicalAddress::parse(frame, 0, address)
+     */
+    template <class T>
+    static bool parse(const CECFrameView &frame, size_t startPos, T &out) noexcept {
+        if (startPos >= frame.length()) {
+            return false;
+        }
+        try {
+            T value(frame, startPos);
+            if (!value.validate()) {
+                return false;
+            }
+            out = value;
+        }
+        catch (...) {
+            return false;
+        }
+        return true;
+    }
+
+    template <class T>
+    static bool parse(const CECFrameView &frame, size_t startPos, size_t len, T &out) noexcept {
+        if (startPos >= frame.length() || len == 0) {
+            return false;
+        }
+        if (len > frame.length() - startPos) {
+            len = frame.length() - startPos;
+        }
+        try {
+            T value(frame, startPos, len);
+            if (!value.validate()) {
+                return false;
+            }
+            out = value;
+        }
+        catch (...) {
+            return false;
+        }
+        return true;
+    }
+
 protected:
-    std::vector<uint8_t> str;
+    CECByteArray str;
     virtual size_t getMaxLen(void) const {
         return CECFrame::MAX_LENGTH;
     }
@@ -124,7 +239,7 @@ public:
         validate();
     }
 
-    OSDString(const CECFrame &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) {
+    OSDString(const CECFrameView &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) {
     }
 
 	const std::string toString(void) const {
@@ -145,7 +260,7 @@ public:
         validate();
     }
 
-    OSDName(const CECFrame &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) {
+    OSDName(const CECFrameView &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) {
     }
 
 	const std::string toString(void) const {
@@ -202,7 +317,7 @@ public :
         return str[0];
     }
 
-	AbortReason(const CECFrame &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) { } 
+	AbortReason(const CECFrameView &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) { } 
 
 
 protected:
@@ -257,7 +372,7 @@ public :
 		return (/*(str[0] >= TV) && */(str[0] <= VIDEO_PROCESSOR));
 	}
 
-	DeviceType(const CECFrame &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) {}
+	DeviceType(const CECFrameView &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) {}
 
 	~DeviceType(void) {}
 
@@ -276,7 +391,7 @@ public:
         Assert(strlen(str) <= MAX_LEN);
     }
 
-    Language(const CECFrame &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) {
+    Language(const CECFrameView &frame, size_t startPos) : CECBytes(frame, startPos, MAX_LEN) {
     }
 
 	const std::string toString(void) const {
@@ -305,7 +420,7 @@ public:
 	VendorID(const uint8_t *buf, size_t len) : CECBytes (buf, len > MAX_LEN ? MAX_LEN : len) {
     }
 
-	VendorID(const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+	VendorID(const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
     };
 
 protected:
@@ -331,7 +446,11 @@ class PhysicalAddress : public CECBytes
         Assert(len >= MAX_LEN);
     }
 
-	PhysicalAddress(const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+	PhysicalAddress(const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+        /* A truncated address would be read past its end by getByteValue() */
+        if (str.size() != MAX_LEN) {
+            throw InvalidParamException();
+        }
     };
 
 	PhysicalAddress(std::string &addr)         : CECBytes (NULL, 0) {
@@ -440,6 +559,12 @@ public:
     LogicalAddress(int addr = UNREGISTERED) : CECBytes((uint8_t)addr) { };
 
     const std::string toString(void) const
+    {
+        return getName();
+    }
+
+    /* Same as toString(), without building a std::string */
+    const char * getName(void) const
     {
     	static const char *names_[] = {
     	"TV",
@@ -507,7 +632,7 @@ public:
         return _type[str[0]];
     }
 
-	LogicalAddress(const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+	LogicalAddress(const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
     };
 protected:
 	size_t getMaxLen() const {return MAX_LEN;}
@@ -559,7 +684,7 @@ public:
 		}
 	}
 
-	Version (const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+	Version (const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
     };
 protected:
 	size_t getMaxLen() const {return MAX_LEN;}
@@ -613,7 +738,7 @@ public:
 		return str[0];
 	}
 
-	PowerStatus (const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+	PowerStatus (const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
 	};
 
 protected:
@@ -646,7 +771,7 @@ class RequestAudioFormat : public CECBytes
           SAD_FMT_CODE_EXTENDED,		//  15
 	};
 	RequestAudioFormat(uint8_t AudioFormatIdCode) : CECBytes((uint8_t)AudioFormatIdCode) { };
-        RequestAudioFormat(const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos,MAX_LEN) { };
+        RequestAudioFormat(const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos,MAX_LEN) { };
 	const std::string toString(void) const
         {
 		static const char *AudioFormtCode[] = {
@@ -714,7 +839,7 @@ class ShortAudioDescriptor : public CECBytes
 	ShortAudioDescriptor(uint8_t *buf, size_t len = MAX_LEN) : CECBytes(buf, MAX_LEN) {
                Assert(len >= MAX_LEN);
         };
-        ShortAudioDescriptor(const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos,MAX_LEN) {
+        ShortAudioDescriptor(const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos,MAX_LEN) {
 		   };
 	const std::string toString(void) const
         {
@@ -813,7 +938,7 @@ public:
 		return str[0];
 	}
 
-	SystemAudioStatus (const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+	SystemAudioStatus (const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
 	};
 
 protected:
@@ -846,7 +971,7 @@ class AudioStatus : public CECBytes
 	int getAudioVolume(void) const {
 		return (str[0] & 0x7F);
         }
-	AudioStatus ( const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+	AudioStatus ( const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
 	};
 protected:
 	size_t getMaxLen() const {return MAX_LEN;}
@@ -891,7 +1016,7 @@ public:
         return str[0];
     }
 
-    UICommand ( const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+    UICommand ( const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
 	            };
 
 protected:
@@ -916,7 +1041,7 @@ public:
     AllDeviceTypes(uint8_t types) : CECBytes((uint8_t)types) { };
 
 
-    AllDeviceTypes( const CECFrame &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
+    AllDeviceTypes( const CECFrameView &frame, size_t startPos) : CECBytes (frame, startPos, MAX_LEN) {
     }
 
     std::vector<std::string> getAllDeviceTypes(void) const {
@@ -1020,7 +1145,7 @@ public:
     RcProfile(uint8_t info) : CECBytes((uint8_t)info) { };
 
 
-    RcProfile( const CECFrame &frame, size_t startPos, size_t len) : CECBytes (frame, startPos, len) {
+    RcProfile( const CECFrameView &frame, size_t startPos, size_t len) : CECBytes (frame, startPos, len) {
     };
 
     std::vector<std::string> getRcProfile(void) const {
@@ -1174,7 +1299,7 @@ public:
     DeviceFeatures(uint8_t info) : CECBytes((uint8_t)info) { };
 
 
-    DeviceFeatures( const CECFrame &frame, size_t startPos, size_t len) : CECBytes (frame, startPos, len) {};
+    DeviceFeatures( const CECFrameView &frame, size_t startPos, size_t len) : CECBytes (frame, startPos, len) {};
 
     std::vector<std::string> getDeviceFeatures() const{
 
@@ -1293,7 +1418,7 @@ public:
     LatencyInfo(uint8_t info) : CECBytes((uint8_t)info) { };
 
 
-    LatencyInfo ( const CECFrame &frame, size_t startPos, size_t len) : CECBytes (frame, startPos, len) {};
+    LatencyInfo ( const CECFrameView &frame, size_t startPos, size_t len) : CECBytes (frame, startPos, len) {};
 
     uint8_t getVideoLatency(void) const {
         return str[0];
@@ -0,0 +1,127 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_RESPONSE_CACHE_HPP_
+#define HDMI_CCEC_RESPONSE_CACHE_HPP_
+
+#include <atomic>
+
+#include "osal/Mutex.hpp"
+#include "ccec/CCEC.hpp"
+#include "ccec/CECFrame.hpp"
+#include "ccec/DataBlock.hpp"
+#include "ccec/Operands.hpp"
+#include "ccec/Host.hpp"
+
+using CCEC_OSAL::Mutex;
+
+CCEC_BEGIN_NAMESPACE
+
+/**
+ * @brief Cache of encoded reply frames, keyed by opcode and destination.
+ *
+ * Only replies that depend on host state alone are cached:
+ * <Report Physical Address>, <Device Vendor ID>, <Set OSD Name>, <CEC Version>
+ * and <Report Power Status>. A reply is built and encoded once with put(), then
+ * handed to the writer with get() until the host state it depends on changes.
+ *
+ * A reply encoded from host state that changes before put() runs must not be
+ * stored. Callers read getGeneration() before they encode the reply and pass it
+ * to put(), which refuses the frame if the opcode was invalidated in between.
+ *
+ * Entries are dropped with invalidate()/invalidateAll(), or automatically by
+ * installing the cache's host hooks with chainHostCallbacks():
+ * hotplug drops everything (the physical address may have changed), a power
+ * state change drops <Report Power Status> and an OSD name change drops
+ * <Set OSD Name>.
+ * @ingroup HDMI_CEC_MSG_N_FRAME_CLASSES
+ */
+class ResponseCache {
+public:
+	enum {
+		MAX_DESTINATIONS = 16,
+	};
+
+	static ResponseCache & getInstance(void);
+
+	ResponseCache(void);
+
+	static bool isCacheable(Op_t opCode);
+
+	bool get(Op_t opCode, const LogicalAddress &from, const LogicalAddress &to, CECFrame &frame) const;
+	uint32_t getGeneration(Op_t opCode) const;
+	bool put(const CECFrame &frame, uint32_t generation);
+	void invalidate(Op_t opCode);
+	void invalidateAll(void);
+
+	static CECHost_Callback_t chainHostCallbacks(const CECHost_Callback_t &callbacks);
+
+	static CECHost_Err_t onHotplug(int32_t connect);
+	static CECHost_Err_t onPowerState(int32_t curState, int32_t newState);
+	static CECHost_Err_t onOSDName(uint8_t *name, size_t len);
+
+private:
+	enum {
+		MAX_OPCODES = 5,
+	};
+
+	static int indexOf(Op_t opCode);
+
+	/*
+	 * Each entry is a sequence lock over the frame bytes, so get() never blocks
+	 * on the mutex that serializes the writers. Word 0 holds the frame length
+	 * in its low byte, followed by the frame bytes.
+	 */
+	enum {
+		WORDS = 3,
+	};
+
+	struct Entry {
+		std::atomic<uint32_t> seq;
+		std::atomic<uint64_t> words[WORDS];
+	};
+
+	void store(Entry &entry, const CECFrame *frame);
+
+	Entry entries[MAX_OPCODES][MAX_DESTINATIONS];
+	/* Bumped by every invalidation of the opcode, under mutex */
+	std::atomic<uint32_t> generations[MAX_OPCODES];
+	Mutex mutex;
+
+	ResponseCache(const ResponseCache &); /* Not allowed */
+	ResponseCache & operator = (const ResponseCache &); /* Not allowed */
+};
+
+CCEC_END_NAMESPACE
+
+#endif
+
+
+/** @} */
+/** @} */
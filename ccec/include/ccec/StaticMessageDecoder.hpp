@@ -0,0 +1,203 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_STATIC_MESSAGE_DECODER_HPP_
+#define HDMI_CCEC_STATIC_MESSAGE_DECODER_HPP_
+
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include "CCEC.hpp"
+#include "ccec/CECFrame.hpp"
+#include "ccec/CECFrameView.hpp"
+#include "ccec/Header.hpp"
+#include "ccec/OpCode.hpp"
+#include "ccec/Messages.hpp"
+#include "ccec/MessageProcessor.hpp"
+#include "ccec/Util.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+/**
+ * @brief True if Processor has a process(const M &, const Header &) overload.
+ */
+template <class Processor, class M>
+class HasProcess
+{
+	template <class P>
+	static char test(decltype(std::declval<P &>().process(std::declval<const M &>(), std::declval<const Header &>())) *);
+	template <class P>
+	static long test(...);
+
+public:
+	enum {
+		value = (sizeof(test<Processor>(0)) == sizeof(char)),
+	};
+};
+
+/**
+ * @brief Header-only counterpart of MessageDecoder that calls Processor::process() directly.
+ *
+ * Processor is any class with process(const Msg &, const Header &) overloads; it does not
+ * have to derive from MessageProcessor, and its overloads need not be virtual, so the
+ * compiler can inline the whole decode and dispatch. Messages the processor has no overload
+ * for are detected at compile time and dropped without being decoded.
+ * @n @n
+ * StaticMessageDecoder<MessageProcessor> behaves like MessageDecoder, including the opcode
+ * interest set. Handlers registered with MessageDecoder::registerHandler() are not consulted.
+ * @code
+ * struct KeyProcessor {
+ *     void process(const UserControlPressed &msg, const Header &header) { ... }
+ * } keys;
+ * StaticMessageDecoder<KeyProcessor>(keys).decode(frame);
+ * @endcode
+ * @ingroup HDMI_CEC_MSG_N_FRAME_CLASSES
+ */
+template <class Processor>
+class StaticMessageDecoder
+{
+public:
+	StaticMessageDecoder(Processor &processor) : processor(processor) {}
+
+	void decode(const CECFrame &in_) {
+		const int HEADER_OFFSET = 0;
+		const int OPCODE_OFFSET = 1;
+		const int OPRAND_OFFSET = 2;
+
+		Header header(in_, HEADER_OFFSET);
+
+		if (in_.length() == 1) {
+			/* This is an Polling Message */
+			dispatch<Polling>(header);
+			return;
+		}
+
+		uint8_t opCode = in_.at(OPCODE_OFFSET);
+		if (!isInterested(opCode, std::is_base_of<MessageProcessor, Processor>()) || !IsValidFrame(in_)) {
+			return;
+		}
+
+		CECFrameView in(in_, OPRAND_OFFSET);
+
+		try {
+			switch (opCode) {
+			case ACTIVE_SOURCE:                  dispatch<ActiveSource>(in, header); break;
+			case INACTIVE_SOURCE:                dispatch<InActiveSource>(in, header); break;
+			case IMAGE_VIEW_ON:                  dispatch<ImageViewOn>(header); break;
+			case TEXT_VIEW_ON:                   dispatch<TextViewOn>(header); break;
+			case REQUEST_ACTIVE_SOURCE:          dispatch<RequestActiveSource>(header); break;
+			case STANDBY:                        dispatch<Standby>(header); break;
+			case GET_CEC_VERSION:                dispatch<GetCECVersion>(header); break;
+			case CEC_VERSION:                    dispatch<CECVersion>(in, header); break;
+			case SET_MENU_LANGUAGE:              dispatch<SetMenuLanguage>(in, header); break;
+			case GIVE_OSD_NAME:                  dispatch<GiveOSDName>(header); break;
+			case GIVE_PHYSICAL_ADDRESS:          dispatch<GivePhysicalAddress>(header); break;
+			case REPORT_PHYSICAL_ADDRESS:        dispatch<ReportPhysicalAddress>(in, header); break;
+			case GIVE_DEVICE_VENDOR_ID:          dispatch<GiveDeviceVendorID>(header); break;
+			case ROUTING_CHANGE:                 dispatch<RoutingChange>(in, header); break;
+			case ROUTING_INFORMATION:            dispatch<RoutingInformation>(in, header); break;
+			case SET_STREAM_PATH:                dispatch<SetStreamPath>(in, header); break;
+			case GET_MENU_LANGUAGE:              dispatch<GetMenuLanguage>(header); break;
+			case DEVICE_VENDOR_ID:               dispatch<DeviceVendorID>(in, header); break;
+			case SET_OSD_STRING:                 dispatch<SetOSDString>(in, header); break;
+			case SET_OSD_NAME:                   dispatch<SetOSDName>(in, header); break;
+			case USER_CONTROL_RELEASED:          dispatch<UserControlReleased>(header); break;
+			case USER_CONTROL_PRESSED:           dispatch<UserControlPressed>(in, header); break;
+			case GIVE_DEVICE_POWER_STATUS:       dispatch<GiveDevicePowerStatus>(header); break;
+			case REPORT_POWER_STATUS:            dispatch<ReportPowerStatus>(in, header); break;
+			case FEATURE_ABORT:                  dispatch<FeatureAbort>(in, header); break;
+			case ABORT:                          dispatch<Abort>(header); break;
+			case INITIATE_ARC:                   dispatch<InitiateArc>(header); break;
+			case TERMINATE_ARC:                  dispatch<TerminateArc>(header); break;
+			case REQUEST_SHORT_AUDIO_DESCRIPTOR: dispatch<RequestShortAudioDescriptor>(in, header); break;
+			case REPORT_SHORT_AUDIO_DESCRIPTOR:  dispatch<ReportShortAudioDescriptor>(in, header); break;
+			case SYSTEM_AUDIO_MODE_REQUEST:      dispatch<SystemAudioModeRequest>(in, header); break;
+			case SET_SYSTEM_AUDIO_MODE:          dispatch<SetSystemAudioMode>(in, header); break;
+			case REPORT_AUDIO_STATUS:            dispatch<ReportAudioStatus>(in, header); break;
+			case GIVE_FEATURES:                  dispatch<GiveFeatures>(header); break;
+			case REPORT_FEATURES:                dispatch<ReportFeatures>(in, header); break;
+			case REQUEST_CURRENT_LATENCY:        dispatch<RequestCurrentLatency>(in, header); break;
+			case REPORT_CURRENT_LATENCY:         dispatch<ReportCurrentLatency>(in, header); break;
+			default:
+				break;
+			}
+		}
+		catch (std::exception &e) {
+			CCEC_LOG( LOG_EXP, "StaticMessageDecoder::decode caught %s \r\n", e.what());
+		}
+	}
+
+private:
+	template <class M>
+	void dispatch(const CECFrameView &in, const Header &header) {
+		dispatch<M>(in, header, std::integral_constant<bool, HasProcess<Processor, M>::value>());
+	}
+
+	template <class M>
+	void dispatch(const CECFrameView &in, const Header &header, std::true_type) {
+		processor.process(M(in), header);
+	}
+
+	template <class M>
+	void dispatch(const CECFrameView &in, const Header &header, std::false_type) {
+	}
+
+	template <class M>
+	void dispatch(const Header &header) {
+		dispatch<M>(header, std::integral_constant<bool, HasProcess<Processor, M>::value>());
+	}
+
+	template <class M>
+	void dispatch(const Header &header, std::true_type) {
+		processor.process(M(), header);
+	}
+
+	template <class M>
+	void dispatch(const Header &header, std::false_type) {
+	}
+
+	bool isInterested(Op_t opCode, std::true_type) const {
+		return processor.isInterested(opCode);
+	}
+
+	bool isInterested(Op_t opCode, std::false_type) const {
+		return true;
+	}
+
+	Processor &processor;
+};
+
+CCEC_END_NAMESPACE
+
+#endif
+
+
+/** @} */
+/** @} */
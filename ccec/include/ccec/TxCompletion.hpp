@@ -0,0 +1,149 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_TX_COMPLETION_HPP_
+#define HDMI_CCEC_TX_COMPLETION_HPP_
+
+#include <stdint.h>
+#include <memory>
+
+#include "ccec/CCEC.hpp"
+#include "ccec/Driver.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+class TxCompletion;
+
+/**
+ * @brief Notified by the Bus writer thread when an async frame is completed.
+ * The callback runs on the writer thread and must not block.
+ * @ingroup HDMI_CEC_CONNECTION
+ */
+class TxCompletionListener
+{
+public:
+	virtual void onTxCompleted(const TxCompletion &completion) = 0;
+	virtual ~TxCompletionListener(void) {}
+};
+
+/**
+ * @brief How the Bus writer retries a frame that was not ACKed.
+ *
+ * The frame is sent up to maxAttempts times. The first retry waits backoff
+ * milliseconds; with BACKOFF_EXPONENTIAL every further retry waits twice as
+ * long as the previous one, up to maxBackoff. No attempt is started after the
+ * deadline, if one is set (microseconds of GetMonotonicTimeUs()); a retry that
+ * would be due after it is made at the deadline instead. Nor is the frame held
+ * back past the deadline for a device that keeps NACKing.
+ *
+ * Only NACKs, bus errors and driver timeouts are retried. A frame that runs out
+ * of attempts after a NACK completes with SEND_TIMED_OUT.
+ * @ingroup HDMI_CEC_CONNECTION
+ */
+class TxRetryPolicy
+{
+public:
+	typedef enum {
+		BACKOFF_FIXED = 0,
+		BACKOFF_EXPONENTIAL,
+	} Backoff;
+
+	enum {
+		DEFAULT_BACKOFF_MS = 250,
+		DEFAULT_MAX_BACKOFF_MS = 2000,
+	};
+
+	TxRetryPolicy(int maxAttempts = 1, uint32_t backoff = DEFAULT_BACKOFF_MS, Backoff type = BACKOFF_FIXED, uint64_t deadline = 0)
+	: maxAttempts(maxAttempts), backoff(backoff), maxBackoff(DEFAULT_MAX_BACKOFF_MS), type(type), deadline(deadline) {}
+
+	static TxRetryPolicy forTimeout(int timeout);
+
+	bool isRetrying(void) const;
+	bool getRetryTime(int attempts, SendResult result, uint64_t now, uint64_t &when) const;
+
+	int maxAttempts;
+	uint32_t backoff;
+	uint32_t maxBackoff;
+	Backoff type;
+	uint64_t deadline;
+};
+
+/**
+ * @brief Handle to the outcome of a frame queued with sendAsync().
+ *
+ * The handle is cheap to copy; all copies refer to the same frame. Once the
+ * writer is done with the frame, including any retries, the handle holds the
+ * final result, the number of attempts and when the frame was queued, first
+ * taken by the writer and completed. Timestamps are in microseconds of GetMonotonicTimeUs().
+ *
+ * A default-constructed handle refers to no frame: it is never done and wait()
+ * returns SEND_INVALID_STATE straight away.
+ * @ingroup HDMI_CEC_CONNECTION
+ */
+class TxCompletion
+{
+public:
+	TxCompletion(void);
+
+	bool isValid(void) const;
+	bool isDone(void) const;
+
+	SendResult wait(void) const;
+	bool wait(long timeout, SendResult &result) const;
+
+	SendResult getResult(void) const;
+	int getAttempts(void) const;
+	uint64_t getQueuedTime(void) const;
+	uint64_t getStartedTime(void) const;
+	uint64_t getCompletedTime(void) const;
+
+private:
+	friend class Bus;
+	friend class TxQueue;
+
+	struct State;
+
+	static TxCompletion create(TxCompletionListener *listener, TxPriority priority = TX_PRIORITY_RESPONSE,
+	                           const TxRetryPolicy &policy = TxRetryPolicy());
+	TxPriority getPriority(void) const;
+	uint64_t getDeadline(void) const;
+	void start(void) const;
+	bool getRetryTime(SendResult result, uint64_t now, uint64_t &when) const;
+	void complete(SendResult result) const;
+
+	std::shared_ptr<State> state;
+};
+
+CCEC_END_NAMESPACE
+
+#endif
+
+
+/** @} */
+/** @} */
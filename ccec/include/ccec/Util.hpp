@@ -29,6 +29,7 @@
 #ifndef HDMI_CCEC_UTIL_HPP_
 #define HDMI_CCEC_UTIL_HPP_
 
+#include <stdint.h>
 #include "ccec/CCEC.hpp"
 
 CCEC_BEGIN_NAMESPACE
@@ -66,6 +67,7 @@ public:
 void check_cec_log_status(void);
 void CCEC_LOG(int level,const char *format, ...);
 void dump_buffer(unsigned char * buf, int len);
+uint64_t GetMonotonicTimeUs(void);
 
 //#define CCEC_DBG_PRINTF(x) do{printf x;}while(0)
 //#define CCEC_ERR_PRINTF(x) do{printf x;}while(0)
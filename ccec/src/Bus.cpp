@@ -37,6 +37,7 @@
 #include <stdio.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <algorithm>
 #include "ccec/CECFrame.hpp"
 #include "ccec/FrameListener.hpp"
 #include "ccec/Driver.hpp"
@@ -50,6 +51,54 @@ using CCEC_OSAL::Thread;
 
 CCEC_BEGIN_NAMESPACE
 
+/* Set on the reader thread while it notifies the listeners */
+static thread_local bool inDispatch = false;
+
+/* Set on the writer thread, which runs the TxCompletionListeners */
+static thread_local bool onWriter = false;
+
+/*
+ * Marks a dispatch in progress for as long as it is in scope, and wakes the
+ * threads waiting for it to end, see Bus::removeFrameListener()
+ */
+class DispatchGuard {
+public:
+	DispatchGuard(std::atomic<uint32_t> &seq, std::atomic<int> &waiters, std::mutex &mutex, std::condition_variable &done)
+	: seq(seq), waiters(waiters), mutex(mutex), done(done) {
+		seq.fetch_add(1);
+		inDispatch = true;
+	}
+	~DispatchGuard(void) {
+		inDispatch = false;
+		seq.fetch_add(1);
+		/* Sequentially consistent, paired with the waiter registering before it checks seq */
+		if (waiters.load() > 0) {
+			std::lock_guard<std::mutex> lock_(mutex);
+			done.notify_all();
+		}
+	}
+private:
+	std::atomic<uint32_t> &seq;
+	std::atomic<int> &waiters;
+	std::mutex &mutex;
+	std::condition_variable &done;
+};
+
+/* Hands the received frame back to the driver once it has been dispatched */
+class FrameGuard {
+public:
+	FrameGuard(Driver &driver) : driver(driver), frame(driver.acquireFrame()) {}
+	~FrameGuard(void) {
+		driver.releaseFrame();
+	}
+	const CECFrame & get(void) const {
+		return frame;
+	}
+private:
+	Driver &driver;
+	const CECFrame &frame;
+};
+
 /**
  * @brief This function is used to create the instance of Bus class.
  *
@@ -67,7 +116,7 @@ Bus & Bus::getInstance(void)
  *
  * @return None
  */
-Bus::Bus(void) : reader(*this), writer(*this), started(false)
+Bus::Bus(void) : reader(*this), writer(*this), listeners(new ListenerList()), listenerVersion(0), dispatchSeq(0), dispatchWaiters(0), txPool("tx"), coalescing(false), started(false)
 {
 	CCEC_LOG( LOG_DEBUG, "Bus Instance Created\r\n");
 	Thread(this->reader).start();
@@ -111,13 +160,16 @@ CCEC_LOG( LOG_INFO, "Bus::stop is called\r\n");
 	}
 	/* coverity[sleep : FALSE] */
 	reader.stop(true);
-		/* coverity[sleep : FALSE] */
-        {AutoLock rlock_(rMutex), wlock_(wMutex);
-	    writer.stop(true);
-	}
+	/*
+	 * No Bus lock is held while waiting for the writer: it may be running a
+	 * TxCompletionListener that calls back into the Bus.
+	 */
+	/* coverity[sleep : FALSE] */
+	writer.stop(true);
 
 	Driver::getInstance().close();
 	CCEC_LOG( LOG_INFO, "Bus::stop is called reader isstop :%d writer isstop :%d \r\n",reader.isStopped(),writer.isStopped());
+	CCEC_LOG( LOG_INFO, "Bus::stop tx frame pool high water %zu, exhausted %zu\r\n", txPool.getHighWaterMark(), txPool.getExhaustedCount());
 }
 
 /**
@@ -145,7 +197,7 @@ Bus::~Bus(void)
  */
 void Bus::Reader::run(void)
 {
-	CECFrame frame;
+	Driver &driver = Driver::getInstance();
 
         if(isStopped())
         {
@@ -155,13 +207,24 @@ void Bus::Reader::run(void)
 	CCEC_LOG( LOG_INFO, "Bus::Reader::run() started\r\n");
 	while (isRunning()) {
 		try {
-			Driver::getInstance().read(frame);
-			{AutoLock lock_(bus.rMutex);
-			    if (bus.listeners.size() == 0) CCEC_LOG( LOG_DEBUG, "Bus::Reader discarding msgs for lack of listener\r\n");
-				std::list<FrameListener *>::iterator list_it;
-				for(list_it = bus.listeners.begin(); list_it!= bus.listeners.end(); list_it++) {
+			/* Listeners get the frame in the driver's slot; it is not copied */
+			FrameGuard frameGuard_(driver);
+			const CECFrame &frame = frameGuard_.get();
+
+			/* Mark the dispatch before loading the snapshot */
+			{DispatchGuard guard_(bus.dispatchSeq, bus.dispatchWaiters, bus.dispatchMutex, bus.dispatchDone);
+				uint32_t version = bus.listenerVersion.load();
+				std::shared_ptr<const ListenerList> snapshot = std::atomic_load(&bus.listeners);
+
+				if (snapshot->size() == 0) CCEC_LOG( LOG_DEBUG, "Bus::Reader discarding msgs for lack of listener\r\n");
+				else driver.printFrameDetails(frame);
+
+				ListenerList::const_iterator list_it;
+				for(list_it = snapshot->begin(); list_it!= snapshot->end(); list_it++) {
+					/* A listener may have removed another one from within notify() */
+					if (bus.listenerVersion.load() != version && !bus.isListening(*list_it)) continue;
+					if (!(*list_it)->isInterested(frame)) continue;
 					CCEC_LOG( LOG_DEBUG, "Bus::Reader::run() notify Listener\r\n");
-					Driver::getInstance().printFrameDetails(frame);
 					(*list_it)->notify(frame);
 					//CCEC_LOG( LOG_DEBUG, "Bus::Reader::run() notify Listener Done\r\n");
 				}
@@ -212,14 +275,19 @@ void Bus::Reader::stop(bool block)
  */
 void Bus::addFrameListener(FrameListener *listener)
 {
-	{AutoLock lock_(rMutex);
+	{AutoLock lock_(lMutex);
 		if (!started) throw InvalidStateException();
-		listeners.push_back(listener);
+
+		std::shared_ptr<ListenerList> copy(new ListenerList(*std::atomic_load(&listeners)));
+		copy->push_back(listener);
+		std::atomic_store(&listeners, std::shared_ptr<const ListenerList>(copy));
+		listenerVersion.fetch_add(1);
 	}
 }
 
 /**
- * @brief This function is used to remove the listener.
+ * @brief This function is used to remove the listener. Once it returns, the
+ * listener is not notified again, so it may be destroyed.
  *
  * @param[in] listener Struct pointer of a listener which is to be removed.
  *
@@ -227,16 +295,46 @@ void Bus::addFrameListener(FrameListener *listener)
  */
 void Bus::removeFrameListener(FrameListener *listener)
 {
-	{ AutoLock lock_(rMutex);
+	{ AutoLock lock_(lMutex);
 	if (!started) throw InvalidStateException();
-		listeners.remove(listener);
+
+		std::shared_ptr<ListenerList> copy(new ListenerList(*std::atomic_load(&listeners)));
+		copy->erase(std::remove(copy->begin(), copy->end(), listener), copy->end());
+		std::atomic_store(&listeners, std::shared_ptr<const ListenerList>(copy));
+		listenerVersion.fetch_add(1);
+	}
+
+	/*
+	 * Grace period: a dispatch that is in progress may still be walking the old
+	 * snapshot, so wait for it to finish. Dispatches that start from now on see
+	 * the new snapshot. When called from within notify() the reader itself skips
+	 * the removed listener instead.
+	 */
+	if (!inDispatch) {
+		uint32_t seq = dispatchSeq.load();
+		if (seq & 1) {
+			std::unique_lock<std::mutex> lock_(dispatchMutex);
+			dispatchWaiters.fetch_add(1);
+			while (dispatchSeq.load() == seq) {
+				dispatchDone.wait(lock_);
+			}
+			dispatchWaiters.fetch_sub(1);
+		}
 	}
+}
 
+bool Bus::isListening(FrameListener *listener) const
+{
+	std::shared_ptr<const ListenerList> snapshot = std::atomic_load(&listeners);
+	return std::find(snapshot->begin(), snapshot->end(), listener) != snapshot->end();
 }
 
 /**
  * @brief This function is used to poll the bus for frame availability and it
- * writes the CEC frame to the driver.
+ * writes the CEC frame to the driver. Frames that fail and are to be retried
+ * wait in the retry wheel and go back to the front of their queue when their
+ * next attempt is due. Frames to other destinations keep flowing in the
+ * meantime; those queued behind the frame to the same destination wait for it.
  *
  * @return None
  */
@@ -246,6 +344,10 @@ void Bus::Writer::run(void)
 	//Driver::getInstance()->open();
 	CCEC_LOG( LOG_INFO, "Bus::Writer::run() started\r\n");
 	CECFrame * outFrame = NULL;
+	TxCompletion completion;
+	std::vector<Retry> due;
+
+	onWriter = true;
 
         if(isStopped())
         {
@@ -255,10 +357,42 @@ void Bus::Writer::run(void)
 	do {
 		CCEC_LOG( LOG_DEBUG, "Bus::Writer::run Looping [%d]\r\n", isRunning());
 
+		/* Wake up every tick while retries are pending */
+		long timeout = (retries.size() > 0) ? (long)(retries.getTick() / 1000) : 0;
+		bool polled = bus.wQueue.poll(outFrame, completion, timeout);
+
+		retries.expire(GetMonotonicTimeUs(), due);
+		for (size_t i = 0; i < due.size(); i++) {
+			bus.wQueue.requeue(due[i].frame, due[i].completion.getPriority(), due[i].completion);
+		}
+		due.clear();
+
+		completeSuperseded();
+
+		if (!polled) {
+			continue;
+		}
+
 		try {
-			outFrame = bus.wQueue.poll();
 			if (outFrame != 0) {
-				Driver::getInstance().write(*outFrame);
+				completion.start();
+				SendResult result = Driver::getInstance().tryWrite(*outFrame);
+				bus.wQueue.reportResult(*outFrame, result);
+
+				uint64_t when;
+				if (result != SEND_ACKED && completion.getRetryTime(result, GetMonotonicTimeUs(), when)) {
+					CCEC_LOG( LOG_DEBUG, "Bus::Writer::run write failed [%s], retrying\r\n", GetSendResultName(result));
+					Retry retry = {outFrame, completion};
+					bus.wQueue.hold(*outFrame, completion.getPriority());
+					retries.schedule(retry, when, GetMonotonicTimeUs());
+					outFrame = NULL;
+				}
+				else {
+					completion.complete(result);
+					if (result != SEND_ACKED) {
+						CCEC_LOG( LOG_EXP, "Bus::Writer::run write failed [%s]\r\n", GetSendResultName(result));
+					}
+				}
 			}
 			else {
 				CCEC_LOG( LOG_DEBUG, "Bus::Writer::run EOF [%d]\r\n", isRunning());
@@ -274,21 +408,50 @@ void Bus::Writer::run(void)
 			e.what();
 		}
 
-		delete outFrame;
+		completion = TxCompletion();
+		bus.txPool.release(outFrame);
 	}
 
 	while (isRunning());
 
 	if (!isRunning()) {
-		while(bus.wQueue.size() > 0) {
-			outFrame = bus.wQueue.poll();
-			delete outFrame;
+		/* Pending retries are completed along with the rest of the queue */
+		retries.drain(due);
+		for (size_t i = 0; i < due.size(); i++) {
+			bus.wQueue.requeue(due[i].frame, due[i].completion.getPriority(), due[i].completion);
+		}
+		due.clear();
+
+		for (;;) {
+			completeSuperseded();
+
+			if (bus.wQueue.size() == 0) {
+				break;
+			}
+			if (bus.wQueue.poll(outFrame, completion, 0)) {
+				completion.complete(SEND_INVALID_STATE);
+				bus.txPool.release(outFrame);
+			}
 		}
 	}
 
 	stopCompleted();
 }
 
+/*
+ * Completes the frames that newer ones replaced in the queue, so that their
+ * listeners run on the writer thread like those of any other frame.
+ */
+void Bus::Writer::completeSuperseded(void)
+{
+	bus.wQueue.takeSuperseded(superseded);
+	for (size_t i = 0; i < superseded.size(); i++) {
+		superseded[i].completion.complete(SEND_SUPERSEDED);
+		bus.txPool.release(superseded[i].frame);
+	}
+	superseded.clear();
+}
+
 /**
  * @brief This function is used to stop the writer for polling the bus and writing
  * to the driver.
@@ -304,7 +467,7 @@ void Bus::Writer::stop(bool block)
 	{AutoLock lock_(bus.wMutex);
 		if (isRunning()) {
 			stopStarted();
-			bus.wQueue.offer(0);
+			bus.wQueue.offer(0, TX_PRIORITY_INTERACTIVE);
 			CCEC_LOG( LOG_DEBUG, "Bus::Writer::stop::stop offer completed [%d]\r\n", isRunning());
 		}
 	}
@@ -330,49 +493,74 @@ void Bus::Writer::stop(bool block)
  * @return None
  */
 void Bus::send(const CECFrame &frame, int timeout)
+{
+	CheckSendResult(trySend(frame, timeout));
+}
+
+/**
+ * @brief Same as send(), but reports the outcome instead of throwing.
+ *
+ * @param[in] frame CEC frame to be sent.
+ * @param[in] timeout Time period for retrying.
+ *
+ * @return SEND_ACKED if the frame was sent, SEND_TIMED_OUT if every retry was
+ * NACKed, otherwise the reason the last attempt failed.
+ */
+SendResult Bus::trySend(const CECFrame &frame, int timeout) noexcept
 {
         if (timeout <= 0) {
-		{AutoLock rlock_(rMutex), wlock_(wMutex);
-			if (!started) throw InvalidStateException();
-			try {
-				Driver::getInstance().write(frame);
-				CCEC_LOG( LOG_DEBUG, "Bus::send write done\r\n");
-			}
-			catch (Exception &e){
-				if( frame.length() > 1)
-				{
-					char buffer[128]={0};
-					snprintf(buffer, 128, "Bus::send exp caught [%s] ", e.what());
-					t2_event_s("HDMI_WARN_CEC_InvalidParamExcptn",buffer);
-					CCEC_LOG( LOG_EXP, "Bus::send exp caught [%s] \r\n", e.what());
-				}
-				throw;
-			}
+		SendResult result;
+
+		/*
+		 * No Bus lock is held during the transmit; the driver serializes transmits
+		 * on its own, so neither the reader nor sendAsync() wait for it.
+		 */
+		{AutoLock lock_(wMutex);
+			if (!started) return SEND_INVALID_STATE;
+		}
+		result = Driver::getInstance().tryWrite(frame);
+
+		reportSendResult(frame, result);
+		return result;
+	}
+
+        /*
+         * Retry in 250ms increment till timeout. The retries are scheduled by the
+         * writer, so this thread only waits for the outcome.
+         */
+        if (onWriter) {
+		/* Called from a TxCompletionListener; the writer cannot wait for itself */
+		int retry = (timeout / TxRetryPolicy::DEFAULT_BACKOFF_MS);
+		SendResult result;
+		while ((result = trySend(frame, 0)) != SEND_ACKED && result != SEND_INVALID_STATE && retry--) {
+			usleep(TxRetryPolicy::DEFAULT_BACKOFF_MS * 1000);
 		}
+		return (result == SEND_NACKED) ? SEND_TIMED_OUT : result;
 	}
 
-        if (timeout > 0) {
-            /* Retry in 250ms increment till timeout */
-            int retry = (timeout / 250);
-            do {
-		    usleep(1000);
-		    {AutoLock rlock_(rMutex), wlock_(wMutex);
-			    try {
-				    if (!started) throw InvalidStateException();
-				    send(frame, 0);
-				    retry = 0;
-			    }
-			    catch (Exception &e){
-				    if( frame.length() > 1) CCEC_LOG( LOG_EXP, "Bus::send exp caught [%s], retry [%d]\r\n", e.what(), retry);
-				    if (retry == 0) {
-					    throw;
-				    }
-			    }
-		    }
-		    if (retry) {
-			    usleep(250000);
-		    }
-	    } while (retry--);
+        TxCompletion completion;
+        try {
+		completion = queue(frame, TX_PRIORITY_INTERACTIVE, NULL, TxRetryPolicy::forTimeout(timeout), false);
+	}
+	catch (...) {
+		return SEND_INVALID_STATE;
+	}
+
+        SendResult result = completion.wait();
+        reportSendResult(frame, result);
+        return result;
+}
+
+void Bus::reportSendResult(const CECFrame &frame, SendResult result)
+{
+	if (result == SEND_ACKED) {
+		CCEC_LOG( LOG_DEBUG, "Bus::send write done\r\n");
+	}
+	else if (frame.length() > 1) {
+		char buffer[128]={0};
+		snprintf(buffer, 128, "Bus::send failed [%s] ", GetSendResultName(result));
+		t2_event_s("HDMI_WARN_CEC_InvalidParamExcptn",buffer);
+		CCEC_LOG( LOG_EXP, "Bus::send failed [%s] \r\n", GetSendResultName(result));
 	}
 }
 
@@ -381,28 +569,77 @@ void Bus::send(const CECFrame &frame, int timeout)
  * keeping copy of cec frame in the queue of the driver.
  *
  * @param[in] frame CEC frame which need to be sent asynchronously.
+ * @param[in] priority Priority class the writer schedules the frame in.
+ * @param[in] listener Notified on the writer thread once the frame is completed, or NULL.
+ * @param[in] policy How the writer retries the frame if it is not ACKed.
  *
- * @return None
+ * @return Handle to the outcome of the frame.
  */
-void Bus::sendAsync(const CECFrame &frame)
+TxCompletion Bus::sendAsync(const CECFrame &frame, TxPriority priority, TxCompletionListener *listener,
+                            const TxRetryPolicy &policy)
 {
+    return queue(frame, priority, listener, policy, coalescing.load(std::memory_order_relaxed));
+}
+
+TxCompletion Bus::queue(const CECFrame &frame, TxPriority priority, TxCompletionListener *listener,
+                        const TxRetryPolicy &policy, bool coalesce)
+{
+    TxCompletion completion = TxCompletion::create(listener, priority, policy);
+    bool replaced = false;
+
     {AutoLock lock_(wMutex);
 
         if (!started) throw InvalidStateException();
 
-        CECFrame *copyFrame = (new CECFrame());
+        CECFrame *copyFrame = txPool.acquire();
         *copyFrame = frame;
-        // Copilot fix: Add exception-safe cleanup to prevent memory leak if offer() throws
         try {
-            wQueue.offer((copyFrame));
+            replaced = wQueue.offer(copyFrame, priority, completion, coalesce);
         }
         catch (...) {
             CCEC_LOG( LOG_EXP, "Exception during copy frame offer...discarding\r\n");
-            delete copyFrame;
+            txPool.release(copyFrame);
             throw;
         }
 
     }
+
+    /* The writer completes the replaced frame, so its listener runs on the writer thread too */
+    if (replaced) {
+        CCEC_LOG( LOG_DEBUG, "Bus::sendAsync queued frame superseded\r\n");
+    }
+
+    return completion;
+}
+
+/**
+ * @brief Turns coalescing of async frames on or off. When on, an async frame
+ * that makes a queued, not yet sent one obsolete (eg a newer <Report Audio
+ * Status> to the same device, or a repeat of the same key press) takes its place
+ * in the queue, and the replaced frame completes with SEND_SUPERSEDED, on the
+ * writer thread like any other completion. Sync sends are never coalesced.
+ *
+ * @param[in] enable TRUE to coalesce, FALSE to queue every frame (default).
+ *
+ * @return None
+ */
+void Bus::setCoalescing(bool enable)
+{
+	coalescing.store(enable, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns how long async frames of a priority class waited for the writer.
+ *
+ * @param[in] priority Priority class.
+ * @param[out] stats Number of frames sent, their total and longest queue wait, and
+ * how many queued frames were superseded.
+ *
+ * @return None
+ */
+void Bus::getTxQueueStats(TxPriority priority, TxQueueStats &stats)
+{
+	wQueue.getStats(priority, stats);
 }
 
 /**
@@ -417,19 +654,29 @@ void Bus::sendAsync(const CECFrame &frame)
  */
 void Bus::poll(const LogicalAddress &from, const LogicalAddress &to)
 {
-	{AutoLock rlock_(rMutex), wlock_(wMutex);
-
-            if (!started) throw InvalidStateException();
-
-            try {
-                Driver::getInstance().poll(from, to);
-                CCEC_LOG( LOG_DEBUG, "Bus::poll done\r\n");
-            }
-            catch (Exception &e){
-                CCEC_LOG( LOG_DEBUG, "Bus::poll exp caught [%s] \r\n", e.what());
-                throw;
-            }
+	CheckSendResult(tryPoll(from, to));
+}
+
+/**
+ * @brief Same as poll(), but reports the outcome instead of throwing.
+ *
+ * @param[in] Logical address of initiator.
+ * @param[in] Logical address of follower.
+ *
+ * @return SEND_NACKED if no device acknowledged the poll.
+ */
+SendResult Bus::tryPoll(const LogicalAddress &from, const LogicalAddress &to) noexcept
+{
+	SendResult result;
+
+	{AutoLock lock_(wMutex);
+            if (!started) return SEND_INVALID_STATE;
     }
+
+    result = Driver::getInstance().tryPoll(from, to);
+
+    CCEC_LOG( LOG_DEBUG, "Bus::poll done [%s]\r\n", GetSendResultName(result));
+    return result;
 }
 
 /**
@@ -444,19 +691,29 @@ void Bus::poll(const LogicalAddress &from, const LogicalAddress &to)
  */
 void Bus::ping(const LogicalAddress &from, const LogicalAddress &to)
 {
-	{AutoLock rlock_(rMutex), wlock_(wMutex);
-
-            if (!started) throw InvalidStateException();
-
-            try {
-                Driver::getInstance().poll(from, to);
-                CCEC_LOG( LOG_DEBUG, "Bus::ping done\r\n");
-            }
-            catch (Exception &e){
-                CCEC_LOG( LOG_DEBUG, "Bus::ping exp caught [%s] \r\n", e.what());
-                throw;
-            }
+	CheckSendResult(tryPing(from, to));
+}
+
+/**
+ * @brief Same as ping(), but reports the outcome instead of throwing.
+ *
+ * @param[in] Logical address of initiator.
+ * @param[in] Logical address of follower.
+ *
+ * @return SEND_ACKED if the device is present, SEND_NACKED if it is not.
+ */
+SendResult Bus::tryPing(const LogicalAddress &from, const LogicalAddress &to) noexcept
+{
+	SendResult result;
+
+	{AutoLock lock_(wMutex);
+            if (!started) return SEND_INVALID_STATE;
     }
+
+    result = Driver::getInstance().tryPoll(from, to);
+
+    CCEC_LOG( LOG_DEBUG, "Bus::ping done [%s]\r\n", GetSendResultName(result));
+    return result;
 }
 
 
@@ -31,18 +31,26 @@
 #define _HDMI_CCEC_BUS_HPP_
 
 #include <list>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include "osal/Mutex.hpp"
 #include "osal/Runnable.hpp"
 #include "osal/Stoppable.hpp"
 #include "osal/Thread.hpp"
-#include "osal/EventQueue.hpp"
 
 #include "ccec/CCEC.hpp"
+#include "ccec/Driver.hpp"
+#include "ccec/TxCompletion.hpp"
+#include "FramePool.hpp"
+#include "TxQueue.hpp"
+#include "TimerWheel.hpp"
 
 using CCEC_OSAL::Runnable;
 using CCEC_OSAL::Stoppable;
-using CCEC_OSAL::EventQueue;
 using CCEC_OSAL::Mutex;
 
 CCEC_BEGIN_NAMESPACE
@@ -56,13 +64,20 @@ public:
     void addFrameListener(FrameListener *listener);
     void removeFrameListener(FrameListener *listener);
     void send(const CECFrame &frame, int timeout = 0);
-    void sendAsync(const CECFrame &frame);
+    TxCompletion sendAsync(const CECFrame &frame, TxPriority priority = TX_PRIORITY_RESPONSE, TxCompletionListener *listener = NULL,
+                           const TxRetryPolicy &policy = TxRetryPolicy());
 	void poll(const LogicalAddress &from, const LogicalAddress &to);
 	void ping(const LogicalAddress &from, const LogicalAddress &to);
+    SendResult trySend(const CECFrame &frame, int timeout = 0) noexcept;
+	SendResult tryPoll(const LogicalAddress &from, const LogicalAddress &to) noexcept;
+	SendResult tryPing(const LogicalAddress &from, const LogicalAddress &to) noexcept;
 
 	void start(void);
 	void stop(void);
 
+	void getTxQueueStats(TxPriority priority, TxQueueStats &stats);
+	void setCoalescing(bool enable);
+
 private:
     class Reader : public Runnable, public Stoppable {
     public:
@@ -75,11 +90,25 @@ private:
 
     class Writer : public Runnable, public Stoppable {
     public:
-    	Writer(Bus &bus) : bus(bus) {}
+    	enum {
+    		RETRY_TICK_MS = 10,
+    	};
+
+    	Writer(Bus &bus) : bus(bus), retries(RETRY_TICK_MS * 1000) {}
     	void run(void);
     	void stop(bool block = true);
     private:
+    	struct Retry {
+    		CECFrame *frame;
+    		TxCompletion completion;
+    	};
+
+    	void completeSuperseded(void);
+
     	Bus &bus;
+    	/* Frames waiting for their next attempt; only touched by the writer thread */
+    	TimerWheel<Retry> retries;
+    	std::vector<TxQueue::Superseded> superseded;
     } writer;
 
 	Bus(void);
@@ -88,10 +117,33 @@ private:
 	~Bus(void);
 
 private:
-	std::list<FrameListener *> listeners;
+	bool isListening(FrameListener *listener) const;
+	static void reportSendResult(const CECFrame &frame, SendResult result);
+	TxCompletion queue(const CECFrame &frame, TxPriority priority, TxCompletionListener *listener,
+	                   const TxRetryPolicy &policy, bool coalesce);
+
+	typedef std::vector<FrameListener *> ListenerList;
+
+	/*
+	 * Listeners are published as an immutable snapshot. Registration copies the
+	 * current list under lMutex and swaps in the copy; the reader dispatches from
+	 * whatever snapshot it loaded, without taking a lock.
+	 */
+	std::shared_ptr<const ListenerList> listeners;
+	/* Bumped on every swap of the snapshot */
+	std::atomic<uint32_t> listenerVersion;
+	/* Odd while the reader is dispatching a frame */
+	std::atomic<uint32_t> dispatchSeq;
+	/* Threads in removeFrameListener() waiting for the dispatch to end, on dispatchDone */
+	std::atomic<int> dispatchWaiters;
+	std::mutex dispatchMutex;
+	std::condition_variable dispatchDone;
+	Mutex lMutex;
 	Mutex rMutex;
 	Mutex wMutex;
-	EventQueue<CECFrame * > wQueue;
+	TxQueue wQueue;
+	FramePool txPool;
+	std::atomic<bool> coalescing;
 	volatile bool started;
 };
 
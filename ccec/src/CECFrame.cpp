@@ -27,6 +27,7 @@
 
 
 #include <cstdio>
+#include <cstring>
 #include <stdexcept>
 #include "ccec/CECFrame.hpp"
 #include "ccec/Util.hpp"
@@ -43,10 +44,10 @@ CECFrame::CECFrame(const uint8_t *buf, size_t len) : len_() {
 
 CECFrame CECFrame::subFrame(size_t start, size_t len) const {
     CECFrame frame;
-    if (len == 0) len = MAX_LENGTH;
-    while(start < len_ && len--) {
-        frame.append(at(start));
-        start++;
+    if (start < len_) {
+        if (len == 0 || len > (size_t)(len_ - start)) len = len_ - start;
+        memcpy(frame.buf_, buf_ + start, len);
+        frame.len_ = (uint8_t)len;
     }
     return frame;
 }
@@ -58,8 +59,11 @@ void CECFrame::append(uint8_t byte) {
 }
 
 void CECFrame::append(const uint8_t *buf, size_t len) {
-	for (size_t i = 0; i < (len); i++) {
-		append(buf[i]);
+	if (len > (size_t)(MAX_LENGTH - len_))
+		throw std::out_of_range("Frame grows beyond maximum");
+	if (len > 0) {
+		memcpy(buf_ + len_, buf, len);
+		len_ += (uint8_t)len;
 	}
 }
 
@@ -86,7 +90,7 @@ const uint8_t * CECFrame::getBuffer(void) const {
 
 uint8_t CECFrame::at(size_t i) const {
 	if (i >= len_) {
-        CCEC_LOG( LOG_DEBUG, "Frame i=%zu, len=%zu\r\n", i, len_);
+        CCEC_LOG( LOG_DEBUG, "Frame i=%zu, len=%zu\r\n", i, (size_t)len_);
         //int *p = NULL;
         //*p = 0xACACACAC;
 		throw std::out_of_range("Frame reads beyond maximum");
@@ -120,12 +120,7 @@ void Connection::removeFrameListener(FrameListener *listener)
  */
 void Connection::sendTo(const LogicalAddress &to, const CECFrame &frame, int timeout)
 {
-	CCEC_LOG( LOG_DEBUG, "Sending out from Connection\r\n");
-	CECFrame fullFrame;
-	Header header(source, to);
-	header.serialize(fullFrame);
-	fullFrame.append(frame);
-	send(fullFrame, timeout);
+	(void) trySendTo(to, frame, timeout);
 }
 
 /**
@@ -139,21 +134,30 @@ void Connection::sendTo(const LogicalAddress &to, const CECFrame &frame, int tim
  * @return None.
  */
 void Connection::sendTo(const LogicalAddress &to, const CECFrame &frame, int timeout, const Throw_e &doThrow)
+{
+	CheckSendResult(trySendTo(to, frame, timeout));
+}
+
+/**
+ * @brief Sends CEC frame to CEC Bus without throwing.
+ *
+ * @param[in] to Logical address of the connection where CEC frame can be sent.
+ * @param[in] frame CEC Frame which is a byte stream that contains raw bytes.
+ * @param[in] timeout It is an upper bound on the amount of time to wait so that the application will not hang during sending.
+ *
+ * @return SEND_ACKED if the frame was sent, otherwise the reason it was not.
+ */
+SendResult Connection::trySendTo(const LogicalAddress &to, const CECFrame &frame, int timeout) noexcept
 {
 	CCEC_LOG( LOG_DEBUG, "Sending out from Connection\r\n");
 	CECFrame fullFrame;
 	Header header(source, to);
 	header.serialize(fullFrame);
-	fullFrame.append(frame);
-	try
-	{
-		send(fullFrame, timeout, doThrow);
-	}
-	catch(Exception &e)
-	{
-		//CCEC_LOG( LOG_EXP, "Catch and re-throw Exception from sendTo\r\n");
-                throw;
+	if (frame.length() > CECFrame::MAX_LENGTH - fullFrame.length()) {
+		return SEND_BUS_ERROR;
 	}
+	fullFrame.append(frame);
+	return trySend(fullFrame, timeout);
 }
 
 /**
@@ -161,16 +165,20 @@ void Connection::sendTo(const LogicalAddress &to, const CECFrame &frame, int tim
  *
  * @param[in] to Logical address of the connection where CEC frame can be sent.
  * @param[in] frame CEC Frame which is a byte stream that contains raw bytes.
+ * @param[in] priority Priority class the frame is sent with.
+ * @param[in] listener Notified on the writer thread once the frame is completed, or NULL.
+ * @param[in] policy How the frame is retried if it is not ACKed. Default: a single attempt.
  *
- * @return None.
+ * @return Handle to the result of the frame.
  */
-void Connection::sendToAsync(const LogicalAddress &to, const CECFrame &frame)
+TxCompletion Connection::sendToAsync(const LogicalAddress &to, const CECFrame &frame, TxPriority priority,
+                                     TxCompletionListener *listener, const TxRetryPolicy &policy)
 {
 	CECFrame fullFrame;
 	Header header(source, to);
 	header.serialize(fullFrame);
 	fullFrame.append(frame);
-	sendAsync(fullFrame);
+	return sendAsync(fullFrame, priority, listener, policy);
 }
 
 /**
@@ -183,17 +191,7 @@ void Connection::sendToAsync(const LogicalAddress &to, const CECFrame &frame)
  */
 void Connection::send(const CECFrame &frame, int timeout)
 {
-	CCEC_LOG( LOG_DEBUG, "Sending out from Connection with timeout %d ms\r\n", timeout);
-	//@TODO: Need to enforce frame's source == connection.source?
-	matchSource(frame);
-        try
-        {
-		bus.send(frame, timeout);
-        }
-	catch(Exception &e)
-        {
-		//CCEC_LOG( LOG_EXP, "Capturing Exception in send and Not sending upwards :: %s\r\n",e.what());
-        }
+	(void) trySend(frame, timeout);
 }
 
 /**
@@ -207,18 +205,23 @@ void Connection::send(const CECFrame &frame, int timeout)
  */
 void Connection::send(const CECFrame &frame, int timeout, const Throw_e &doThrow)
 {
-	CCEC_LOG( LOG_DEBUG, "Sending out from Connection\r\n");
+	CheckSendResult(trySend(frame, timeout));
+}
+
+/**
+ * @brief Sends CEC frame to CEC Bus without throwing.
+ *
+ * @param[in] frame CEC Frame which is a byte stream that contains raw bytes.
+ * @param[in] timeout It is an upper bound on the amount of time to wait so that the application will not hang during sending.
+ *
+ * @return SEND_ACKED if the frame was sent, otherwise the reason it was not.
+ */
+SendResult Connection::trySend(const CECFrame &frame, int timeout) noexcept
+{
+	CCEC_LOG( LOG_DEBUG, "Sending out from Connection with timeout %d ms\r\n", timeout);
 	//@TODO: Need to enforce frame's source == connection.source?
 	matchSource(frame);
-        try
-	{
-		bus.send(frame, timeout);
-        }
-	catch(Exception &e)
-        {
-		//CCEC_LOG(LOG_EXP, "Catch and re-throw Exception from send\r\n");
-		throw;
-	}
+	return bus.trySend(frame, timeout);
 }
 
 /**
@@ -230,20 +233,23 @@ void Connection::send(const CECFrame &frame, int timeout, const Throw_e &doThrow
  * @return None.
  */
 void Connection::poll(const LogicalAddress &from, const Throw_e &doThrow)
+{
+	CheckSendResult(tryPoll(from));
+}
+
+/**
+ * @brief Sends a poll message to the Bus without throwing.
+ *
+ * @param[in] logical address of Initiator, in case of poll the initiator and follower is same.
+ *
+ * @return SEND_NACKED if no device has the address, ie it can be claimed.
+ */
+SendResult Connection::tryPoll(const LogicalAddress &from) noexcept
 {
 	CCEC_LOG( LOG_DEBUG, "Polling\r\n");
-	//@TODO: Need to enforce frame's source == connection.source?
 
-	try
-	{
 	/* polling both initator and follower is same*/
-		bus.poll(from, from);
-     }
-	catch(Exception &e)
-        {
-		//CCEC_LOG(LOG_EXP, "Catch and re-throw Exception from send\r\n");
-		throw;
-	}
+	return bus.tryPoll(from, from);
 }
 
 /**
@@ -255,20 +261,24 @@ void Connection::poll(const LogicalAddress &from, const Throw_e &doThrow)
  * @return None.
  */
 void Connection::ping(const LogicalAddress &from, const LogicalAddress &to, const Throw_e &doThrow)
+{
+	CheckSendResult(tryPing(from, to));
+}
+
+/**
+ * @brief Sends a ping message to the Bus without throwing.
+ *
+ * @param[in] logical address of Initiator, in case of ping the initiator and follower should be different.
+ * @param[in] logical address of Follower.
+ *
+ * @return SEND_ACKED if the device is present, SEND_NACKED if it is not.
+ */
+SendResult Connection::tryPing(const LogicalAddress &from, const LogicalAddress &to) noexcept
 {
 	CCEC_LOG( LOG_DEBUG, "Polling\r\n");
-	//@TODO: Need to enforce frame's source == connection.source?
 
-	try
-	{
 	/* Ping initator and follower should be different*/
-		bus.ping(from, to);
-    }
-	catch(Exception &e)
-    {
-		//CCEC_LOG(LOG_EXP, "Catch and re-throw Exception from send\r\n");
-		throw;
-	}
+	return bus.tryPing(from, to);
 }
 
 
@@ -277,14 +287,20 @@ void Connection::ping(const LogicalAddress &from, const LogicalAddress &to, cons
  * @brief This function is used to send the CEC frame to physical CEC Bus using asynchronous method.
  *
  * @param[in] frame CEC Frame which is a byte stream that contains raw bytes.
+ * @param[in] priority Priority class the frame is sent with. Frames of higher
+ * classes overtake queued frames of lower ones.
+ * @param[in] listener Notified on the writer thread once the frame is completed, or NULL.
+ * @param[in] policy How the frame is retried if it is not ACKed. Default: a single attempt.
  *
- * @return None.
+ * @return Handle to the result of the frame: whether it was ACKed, after how
+ * many attempts, and when it was queued, taken and completed.
  */
-void Connection::sendAsync(const CECFrame &frame)
+TxCompletion Connection::sendAsync(const CECFrame &frame, TxPriority priority, TxCompletionListener *listener,
+                                   const TxRetryPolicy &policy)
 {
 	CCEC_LOG( LOG_DEBUG, "Sending out from Connection\r\n");
 	matchSource(frame);
-	bus.sendAsync(frame);
+	return bus.sendAsync(frame, priority, listener, policy);
 }
 
 /**
@@ -331,6 +347,7 @@ void Connection::DefaultFrameListener::notify(const CECFrame &frame) const
 		if (!filter.isFiltered(frame)) {
 			std::list<FrameListener *>::iterator list_it;
 			for(list_it = connection.frameListeners.begin(); list_it!= connection.frameListeners.end(); list_it++) {
+				if (!(*list_it)->isInterested(frame)) continue;
 				CCEC_LOG( LOG_DEBUG, "connection [%s] frame Listeners notify Listener\r\n", connection.name.c_str());
 				(*list_it)->notify(frame);
 			}
@@ -352,7 +369,7 @@ void Connection::matchSource(const CECFrame &frame)
 {
 	//@TODO: use Header.from/to to do filtering, instead of raw bytes
 	if (Driver::getInstance().isValidLogicalAddress(source)) {
-		CCEC_LOG( LOG_DEBUG, "Mathing source to %s\r\n", source.toString().c_str());
+		CCEC_LOG( LOG_DEBUG, "Mathing source to %s\r\n", source.getName());
 
 		const uint8_t *buf = frame.getBuffer();
 		CCEC_LOG( LOG_DEBUG, "Has source to %x\r\n", (buf[0] >> 4) & 0x0F);
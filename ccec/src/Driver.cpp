@@ -37,6 +37,56 @@ Driver &Driver::getInstance()
 	return instance;
 }
 
+/**
+ * @brief Returns a printable name for a send result.
+ *
+ * @param[in] result Result of a send, poll or ping.
+ *
+ * @return Name of the result.
+ */
+const char *GetSendResultName(SendResult result)
+{
+	switch (result) {
+	case SEND_ACKED:
+		return "Acked";
+	case SEND_NACKED:
+		return "Not acked";
+	case SEND_BUS_ERROR:
+		return "Bus error";
+	case SEND_TIMED_OUT:
+		return "Timed out";
+	case SEND_INVALID_STATE:
+		return "Invalid state";
+	case SEND_SUPERSEDED:
+		return "Superseded";
+	default:
+		return "Unknown";
+	}
+}
+
+/**
+ * @brief Maps a send result onto the exceptions raised by the throwing API:
+ * CECNoAckException for a NACK or timeout, IOException for a bus error and
+ * InvalidStateException when the driver or bus is not running.
+ *
+ * @param[in] result Result of a send, poll or ping.
+ */
+void CheckSendResult(SendResult result) noexcept(false)
+{
+	switch (result) {
+	case SEND_ACKED:
+		return;
+	case SEND_NACKED:
+	case SEND_TIMED_OUT:
+		throw CECNoAckException();
+	case SEND_INVALID_STATE:
+		throw InvalidStateException();
+	case SEND_BUS_ERROR:
+	default:
+		throw IOException();
+	}
+}
+
 CCEC_END_NAMESPACE
 
 
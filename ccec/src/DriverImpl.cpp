@@ -40,7 +40,6 @@
 #include <sys/socket.h>
 #include <stdlib.h>
 
-#include "osal/EventQueue.hpp"
 #include "osal/Exception.hpp"
 #include "ccec/Util.hpp"
 #include "ccec/Exception.hpp"
@@ -57,8 +56,12 @@ size_t write(const unsigned char *buf, size_t len);
 
 void DriverImpl::DriverReceiveCallback(int handle, void *callbackData, unsigned char *buf, int len)
 {
-	CECFrame *frame = new CECFrame();
-	frame->append((unsigned char *)buf, (size_t)len);
+	if (buf == NULL || len <= 0 || len > CECFrame::MAX_LENGTH) {
+		CCEC_LOG( LOG_EXP, "Invalid frame length %d from driver...discarding\r\n", len);
+		return;
+	}
+
+	DriverImpl &driver = static_cast<DriverImpl &>(Driver::getInstance());
 
 	CCEC_LOG( LOG_DEBUG, ">>>>>>> >>>>> >>>> >> >> >\r\n");
 
@@ -66,13 +69,14 @@ void DriverImpl::DriverReceiveCallback(int handle, void *callbackData, unsigned
 
 	CCEC_LOG(LOG_DEBUG, "==========================\r\n");
 
-	try {
-		static_cast<DriverImpl &>(Driver::getInstance()).getIncomingQueue(handle).offer(frame);
-	}
-	catch(...) {
-		CCEC_LOG( LOG_EXP, "Exception during frame offer...discarding\r\n");
-		// Copilot fix: Delete frame to prevent memory leak when offer() throws exception
-		delete frame;
+	if (!driver.rxRing.push(buf, (size_t)len)) {
+		/* The reader is behind, or the driver is closing */
+		RxStats stats;
+		driver.rxRing.getStats(stats);
+		if (stats.dropped % 100 == 1) {
+			CCEC_LOG( LOG_WARN, "Incoming queue full...%u frames discarded so far\r\n", stats.dropped);
+		}
+		return;
 	}
 	CCEC_LOG( LOG_DEBUG, "frame offered\r\n");
 }
@@ -84,25 +88,21 @@ void DriverImpl::DriverTransmitCallback(int handle, void *callbackData, int resu
 	}
 }
 
-DriverImpl::DriverImpl() : status(CLOSED), nativeHandle(0)
+DriverImpl::DriverImpl() : status(CLOSED), nativeHandle(0), rxRing()
 {
 	CCEC_LOG( LOG_DEBUG, "Creating DriverImpl done\r\n");
 }
 
 DriverImpl::~DriverImpl()
 {
-    {AutoLock lock_(mutex);
-		if (status != CLOSED) {
-			try{
-                this->close();
-	        }
-	        catch(Exception &e)
-	        {
-                CCEC_LOG( LOG_EXP, "DriverImpl: Caught Exception while calling ~DriverImpl::close()\r\n");
-
-            }
-		}
-    }
+	/* close() checks the status itself; taking mutex here would invert the txMutex -> mutex order */
+	try{
+		this->close();
+	}
+	catch(Exception &e)
+	{
+		CCEC_LOG( LOG_EXP, "DriverImpl: Caught Exception while calling ~DriverImpl::close()\r\n");
+	}
 }
 
 void DriverImpl::open(void) noexcept(false)
@@ -121,6 +121,7 @@ void DriverImpl::open(void) noexcept(false)
 			throw IOException();
 		}
 
+		rxRing.open();
 		HdmiCecSetRxCallback(nativeHandle, DriverReceiveCallback, 0);
 		HdmiCecSetTxCallback(nativeHandle, DriverTransmitCallback, 0);
 		status = OPENED;
@@ -130,7 +131,8 @@ void DriverImpl::open(void) noexcept(false)
 void  DriverImpl::close(void) noexcept(false)
 {
 
-    {AutoLock lock_(mutex);
+    /* Let a transmit in flight complete before the handle goes away */
+    {AutoLock txlock_(txMutex), lock_(mutex);
 		if (status != OPENED) {
 			#if 0
 				throw InvalidStateException();
@@ -140,8 +142,8 @@ void  DriverImpl::close(void) noexcept(false)
 		}
 		status = CLOSING;
 
-		/* Use NULL as sentinel */
-		rQueue.offer(0);
+		/* Wakes the reader, which flushes what is left and gets InvalidStateException */
+		rxRing.close();
 
 		int err = HdmiCecClose(nativeHandle);
 		if (err != HDMI_CEC_IO_SUCCESS) {
@@ -149,45 +151,45 @@ void  DriverImpl::close(void) noexcept(false)
 		}
 
 		status = CLOSED;
+		RxStats stats;
+		rxRing.getStats(stats);
+		CCEC_LOG( LOG_INFO, "DriverImpl::close rx queue high water %zu, dropped %u, max latency %llu us\r\n",
+				rxRing.getHighWaterMark(), stats.dropped, (unsigned long long)stats.maxLatencyUs);
     }
 }
 
 void  DriverImpl::read(CECFrame &frame)  noexcept(false)
 {
-    {AutoLock lock_(mutex);
-		if (status != OPENED) {
-			throw InvalidStateException();
-		}
-    }
+	frame = acquireFrame();
+	releaseFrame();
+}
 
+/**
+ * @brief Waits for the next received frame and returns it in place, in the slot
+ * the HAL callback copied it to. Only the Bus reader may call this.
+ *
+ * @return The frame, valid until releaseFrame().
+ */
+const CECFrame & DriverImpl::acquireFrame(void) noexcept(false)
+{
     CCEC_LOG( LOG_DEBUG, "DriverImpl::Read()\r\n");
 
-    bool backToPoll = false;
-	do {
-		backToPoll = false;
+	const CECFrame *frame = rxRing.front();
+	if (frame == NULL) {
+		throw InvalidStateException();
+	}
+
+	return *frame;
+}
 
-		CECFrame * inFrame = rQueue.poll();
+void  DriverImpl::releaseFrame(void) noexcept
+{
+	rxRing.pop();
+}
 
-		if (inFrame != 0) {
-			frame = *inFrame;
-			delete inFrame;
-		}
-		else {AutoLock lock_(mutex);
-
-			if (status != OPENED) {
-				/* Flush and return */
-				while (rQueue.size() > 0) {
-					inFrame = rQueue.poll();
-					frame = *inFrame;
-					delete inFrame;
-				}
-				throw InvalidStateException();
-			}
-			else {
-				backToPoll = true;
-			}
-		}
-    } while(backToPoll);
+void  DriverImpl::getRxStats(RxStats &stats)
+{
+	rxRing.getStats(stats);
 }
 
 /*
@@ -202,9 +204,11 @@ void  DriverImpl::writeAsync(const CECFrame &frame)  noexcept(false)
 	frame.getBuffer(&buf, &length);
 	printFrameDetails(frame);
 
-    {AutoLock lock_(mutex);
-    	if (status != OPENED) {
-    		throw InvalidStateException();
+    {AutoLock txlock_(txMutex);
+    	{AutoLock lock_(mutex);
+    		if (status != OPENED) {
+    			throw InvalidStateException();
+    		}
     	}
 		CCEC_LOG( LOG_DEBUG, "DriverImpl::write to call HdmiCecTxAsync\r\n");
 
@@ -232,17 +236,34 @@ void  DriverImpl::writeAsync(const CECFrame &frame)  noexcept(false)
  * Only 1 write is allowed at a time. Queue the write request and wait for response.
  */
 void  DriverImpl::write(const CECFrame &frame)  noexcept(false)
+{
+	CheckSendResult(tryWrite(frame));
+}
+
+/*
+ * Same as write(), but reports the outcome instead of throwing.
+ */
+SendResult DriverImpl::tryWrite(const CECFrame &frame) noexcept
 {
 
 	const uint8_t *buf = NULL;
 	size_t length = 0;
 
 	frame.getBuffer(&buf, &length);
+	if (length == 0) {
+		return SEND_BUS_ERROR;
+	}
 	printFrameDetails(frame);
 
-    {AutoLock lock_(mutex);
-    	if (status != OPENED) {
-    		throw InvalidStateException();
+    /*
+     * Transmits are serialized by txMutex alone. mutex is only held for the status
+     * check, so read() and the other calls are not held up by a transmit in flight.
+     */
+    {AutoLock txlock_(txMutex);
+    	{AutoLock lock_(mutex);
+    		if (status != OPENED) {
+    			return SEND_INVALID_STATE;
+    		}
     	}
 		int sendResult = HDMI_CEC_IO_SUCCESS;
 		CCEC_LOG( LOG_DEBUG, "DriverImpl::write to call HdmiCecTx\r\n");
@@ -258,7 +279,7 @@ void  DriverImpl::write(const CECFrame &frame)  noexcept(false)
 		CCEC_LOG( LOG_DEBUG, "DriverImpl:: call HdmiCecTx DONE %x, result %x\r\n", err, sendResult);
 
 		if (err != HDMI_CEC_IO_SUCCESS) {
-			throw IOException();
+			return SEND_BUS_ERROR;
 		}
 
         if (sendResult != HDMI_CEC_IO_SUCCESS) {
@@ -268,22 +289,23 @@ void  DriverImpl::write(const CECFrame &frame)  noexcept(false)
                 (sendResult == HDMI_CEC_IO_SENT_FAILED) || 
                 (sendResult == HDMI_CEC_IO_GENERAL_ERROR) )
             {
-                throw IOException();
+                return SEND_BUS_ERROR;
             }
         }
 
-		if (((frame.at(0) & 0x0F) != 0x0F) && sendResult == HDMI_CEC_IO_SENT_BUT_NOT_ACKD) {
-			throw CECNoAckException();
+		if (((buf[0] & 0x0F) != 0x0F) && sendResult == HDMI_CEC_IO_SENT_BUT_NOT_ACKD) {
+			return SEND_NACKED;
 		}
 		   /* CEC CTS 9-3-3 -Ensure that the DUT will accept a negatively for broadcat report physical address msg and retry atleast once */
-		else if (((frame.at(0) & 0x0F) == 0x0F) && (length > 1) && ((frame.at(1) & 0xFF) == REPORT_PHYSICAL_ADDRESS ) && (sendResult == HDMI_CEC_IO_SENT_BUT_NOT_ACKD))
+		else if (((buf[0] & 0x0F) == 0x0F) && (length > 1) && ((buf[1] & 0xFF) == REPORT_PHYSICAL_ADDRESS ) && (sendResult == HDMI_CEC_IO_SENT_BUT_NOT_ACKD))
 		{
 
-                   throw CECNoAckException();
+                   return SEND_NACKED;
 		}
     }
 
     CCEC_LOG( LOG_DEBUG, "Send Completed\r\n");
+    return SEND_ACKED;
 }
 
 int DriverImpl::getLogicalAddress(int devType)
@@ -366,32 +388,17 @@ bool DriverImpl::isValidLogicalAddress(const LogicalAddress & source) const
 void DriverImpl::poll(const LogicalAddress &from, const LogicalAddress &to)
      	 	 	 	  noexcept(false)
 {
-	uint8_t firstByte = (((from.toInt() & 0x0F) << 4) | (to.toInt() & 0x0F));
-	CCEC_LOG( LOG_DEBUG, "$$$$$$$$$$$$$$$$$$$$ POST POLL [%s] [%s]$$$$$$$$$$$$$$$$$$$$$\r\n", from.toString().c_str(), to.toString().c_str());
-
-	{
-		CECFrame frame;
-		frame.append(firstByte);
-		write(frame);
-	}
-	
-#if 0
-	{
-		/* Send a Poll so indicate there is a device present */
-		CECFrame *frame = new CECFrame();
-		frame->append(firstByte);
-		rQueue.offer(frame);
-	}
-#endif
+	CheckSendResult(tryPoll(from, to));
 }
 
-DriverImpl::IncomingQueue & DriverImpl::getIncomingQueue(int nativeHandle)
+SendResult DriverImpl::tryPoll(const LogicalAddress &from, const LogicalAddress &to) noexcept
 {
-	if (status != OPENED) {
-		throw InvalidStateException();
-	}
+	uint8_t firstByte = (((from.toInt() & 0x0F) << 4) | (to.toInt() & 0x0F));
+	CCEC_LOG( LOG_DEBUG, "$$$$$$$$$$$$$$$$$$$$ POST POLL [%s] [%s]$$$$$$$$$$$$$$$$$$$$$\r\n", from.getName(), to.getName());
 
-	return rQueue;
+	CECFrame frame;
+	frame.append(firstByte);
+	return tryWrite(frame);
 }
 
 void  DriverImpl::printFrameDetails(const CECFrame &frame)  noexcept(false) {
@@ -408,7 +415,7 @@ void  DriverImpl::printFrameDetails(const CECFrame &frame)  noexcept(false) {
 		}
 		if (frame.length() > OPCODE_OFFSET) {
 			opname = GetOpName(OpCode(frame,OPCODE_OFFSET).opCode());
-			CCEC_LOG( LOG_INFO, "%s to %s : opcode: %s :%s\n",header.from.toString().c_str(), header.to.toString().c_str(), opname, strBuffer);
+			CCEC_LOG( LOG_INFO, "%s to %s : opcode: %s :%s\n",header.from.getName(), header.to.getName(), opname, strBuffer);
 		}
 	}
 	catch(Exception &e)
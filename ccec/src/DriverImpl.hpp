@@ -33,13 +33,12 @@
 #include <list>
 
 #include "osal/Mutex.hpp"
-#include "osal/EventQueue.hpp"
 
 #include "osal/ConditionVariable.hpp"
 #include "ccec/Driver.hpp"
 #include "ccec/Header.hpp"
+#include "RxRing.hpp"
 
-using CCEC_OSAL::EventQueue;
 using CCEC_OSAL::Mutex;
 
 CCEC_BEGIN_NAMESPACE
@@ -47,14 +46,11 @@ CCEC_BEGIN_NAMESPACE
 #define HEADER_OFFSET 0
 #define OPCODE_OFFSET 1
 
-class IncomingQueue;
-
 class DriverImpl : public Driver
 {
 public:
 	static void DriverReceiveCallback(int handle, void *callbackData, unsigned char *buf, int len);
 	static void DriverTransmitCallback(int handle, void *callbackData, int result);
-	typedef EventQueue<CECFrame *> IncomingQueue;
 
 	enum {
 		CLOSED = 0,
@@ -67,6 +63,9 @@ public:
 	virtual void  open(void) noexcept(false);
 	virtual void  close(void) noexcept(false);
 	virtual void  read(CECFrame &frame) noexcept(false);
+	virtual const CECFrame & acquireFrame(void) noexcept(false);
+	virtual void  releaseFrame(void) noexcept;
+	virtual void  getRxStats(RxStats &stats);
 	virtual void  write(const CECFrame &frame) noexcept(false);
 	virtual void  writeAsync(const CECFrame &frame) noexcept(false);
 	virtual void  removeLogicalAddress(const LogicalAddress &source);
@@ -76,15 +75,18 @@ public:
 //	virtual const std::list<LogicalAddress> & getLogicalAddresses(void);
 	virtual bool isValidLogicalAddress(const LogicalAddress &source) const;
 	virtual void poll(const LogicalAddress &from, const LogicalAddress &to) noexcept(false);
+	virtual SendResult tryWrite(const CECFrame &frame) noexcept;
+	virtual SendResult tryPoll(const LogicalAddress &from, const LogicalAddress &to) noexcept;
 	virtual void printFrameDetails(const CECFrame &frame) noexcept(false);
 
 private:
-	IncomingQueue & getIncomingQueue(int nativeHandle);
-
 	int status;
 	int nativeHandle;
-	IncomingQueue rQueue;
+	/* Received frames, from the HAL callback to the Bus reader */
+	RxRing rxRing;
         mutable Mutex mutex;
+	/* Serializes HdmiCecTx(); taken before mutex when both are needed */
+	Mutex txMutex;
 	std::list<LogicalAddress> logicalAddresses;
 
 	DriverImpl(const DriverImpl &); /* Not allowed */
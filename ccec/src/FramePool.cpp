@@ -0,0 +1,144 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#include "FramePool.hpp"
+#include "ccec/Util.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+static const uint32_t kEndOfList = 0xFFFFFFFF;
+
+static inline uint64_t makeHead(uint32_t tag, uint32_t index)
+{
+	return ((uint64_t)tag << 32) | index;
+}
+
+FramePool::FramePool(const char *name) : name(name), inUse(0), highWater(0), exhausted(0)
+{
+	for (uint32_t i = 0; i < CAPACITY; i++) {
+		slots[i].next.store((i + 1 < CAPACITY) ? i + 1 : kEndOfList, std::memory_order_relaxed);
+	}
+	head.store(makeHead(0, 0));
+}
+
+FramePool::~FramePool(void)
+{
+	if (inUse.load() != 0) {
+		CCEC_LOG( LOG_WARN, "FramePool[%s] destroyed with %u frames in use\r\n", name, inUse.load());
+	}
+}
+
+/**
+ * @brief Takes a cleared frame from the pool. Never returns NULL; when the pool
+ * is exhausted the frame is allocated from the heap instead.
+ *
+ * @return Frame to be handed back through release().
+ */
+CECFrame * FramePool::acquire(void)
+{
+	uint64_t oldHead = head.load(std::memory_order_acquire);
+	uint64_t newHead;
+	uint32_t index;
+
+	do {
+		index = (uint32_t)oldHead;
+		if (index == kEndOfList) {
+			if (exhausted.fetch_add(1, std::memory_order_relaxed) == 0) {
+				CCEC_LOG( LOG_WARN, "FramePool[%s] exhausted, falling back to heap\r\n", name);
+			}
+			return new CECFrame();
+		}
+		newHead = makeHead((uint32_t)(oldHead >> 32) + 1, slots[index].next.load(std::memory_order_relaxed));
+	} while (!head.compare_exchange_weak(oldHead, newHead, std::memory_order_acquire, std::memory_order_acquire));
+
+	uint32_t used = inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+	uint32_t mark = highWater.load(std::memory_order_relaxed);
+	while (used > mark && !highWater.compare_exchange_weak(mark, used, std::memory_order_relaxed)) {
+	}
+
+	CECFrame *frame = &slots[index].frame;
+	frame->reset();
+	return frame;
+}
+
+/**
+ * @brief Hands a frame obtained from acquire() back to the pool. NULL is ignored.
+ *
+ * @param[in] frame Frame to be released.
+ */
+void FramePool::release(CECFrame *frame)
+{
+	if (frame == NULL) {
+		return;
+	}
+
+	if (!owns(frame)) {
+		delete frame;
+		return;
+	}
+
+	uint32_t index = (uint32_t)(((const uint8_t *)frame - (const uint8_t *)slots) / sizeof(Slot));
+	/* Count the frame as free before it can be handed out again */
+	inUse.fetch_sub(1, std::memory_order_relaxed);
+
+	uint64_t oldHead = head.load(std::memory_order_relaxed);
+	uint64_t newHead;
+
+	do {
+		slots[index].next.store((uint32_t)oldHead, std::memory_order_relaxed);
+		newHead = makeHead((uint32_t)(oldHead >> 32) + 1, index);
+	} while (!head.compare_exchange_weak(oldHead, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool FramePool::owns(const CECFrame *frame) const
+{
+	const uint8_t *p = (const uint8_t *)frame;
+	return (p >= (const uint8_t *)slots) && (p < (const uint8_t *)(slots + CAPACITY));
+}
+
+size_t FramePool::getInUse(void) const
+{
+	return inUse.load(std::memory_order_relaxed);
+}
+
+size_t FramePool::getHighWaterMark(void) const
+{
+	return highWater.load(std::memory_order_relaxed);
+}
+
+size_t FramePool::getExhaustedCount(void) const
+{
+	return exhausted.load(std::memory_order_relaxed);
+}
+
+CCEC_END_NAMESPACE
+
+
+/** @} */
+/** @} */
@@ -0,0 +1,94 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_FRAME_POOL_HPP_
+#define HDMI_CCEC_FRAME_POOL_HPP_
+
+#include <stdint.h>
+#include <atomic>
+
+#include "ccec/CCEC.hpp"
+#include "ccec/CECFrame.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+/*
+ * Fixed capacity pool of CECFrames.
+ *
+ * Frames that are queued between threads (async sends on their way to the Bus
+ * writer) are taken from a pool instead of the heap. The free list is a lock-free stack, so
+ * acquire() and release() may be called from any thread, including the HAL
+ * callback, without taking a lock or calling malloc.
+ *
+ * If the pool runs dry acquire() falls back to the heap and counts the event;
+ * release() returns each frame to wherever it came from.
+ */
+class FramePool {
+public:
+	enum {
+		CAPACITY = 64,
+	};
+
+	FramePool(const char *name);
+	~FramePool(void);
+
+	CECFrame * acquire(void);
+	void release(CECFrame *frame);
+
+	size_t getInUse(void) const;
+	size_t getHighWaterMark(void) const;
+	size_t getExhaustedCount(void) const;
+
+private:
+	bool owns(const CECFrame *frame) const;
+
+	struct Slot {
+		CECFrame frame;
+		std::atomic<uint32_t> next;
+	};
+
+	const char *name;
+	Slot slots[CAPACITY];
+	/* Index of the first free slot in the low 32 bits, ABA tag in the high 32 bits */
+	std::atomic<uint64_t> head;
+	std::atomic<uint32_t> inUse;
+	std::atomic<uint32_t> highWater;
+	std::atomic<uint32_t> exhausted;
+
+	FramePool(const FramePool &); /* Not allowed */
+	FramePool & operator = (const FramePool &); /* Not allowed */
+};
+
+CCEC_END_NAMESPACE
+
+#endif
+
+
+/** @} */
+/** @} */
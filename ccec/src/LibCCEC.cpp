@@ -183,6 +183,48 @@ void LibCCEC::getPhysicalAddress(unsigned int *physicalAddress)
         return;
 }
 
+/**
+ * @brief This function is used to get how long async frames of a priority
+ * class waited in the transmit queue before they were sent.
+ *
+ * @param[in] priority Priority class.
+ * @param[out] stats Number of frames sent, their total and longest queue wait, and
+ * how many queued frames were superseded.
+ *
+ * @return None
+ */
+void LibCCEC::getTxQueueStats(TxPriority priority, TxQueueStats &stats)
+{
+	Bus::getInstance().getTxQueueStats(priority, stats);
+}
+
+/**
+ * @brief This function is used to let async frames that make a queued frame
+ * obsolete replace it, eg repeated <Report Audio Status> while the volume key
+ * is held. Off by default.
+ *
+ * @param[in] enable TRUE to coalesce queued frames, FALSE to send every frame.
+ *
+ * @return None
+ */
+void LibCCEC::setTxCoalescing(bool enable)
+{
+	Bus::getInstance().setCoalescing(enable);
+}
+
+/**
+ * @brief This function is used to get how many frames were received, how many
+ * were dropped because the reader was behind, and how long they took from the
+ * HAL callback to the FrameListeners.
+ *
+ * @param[out] stats Frames received and dropped, their total and longest latency.
+ *
+ * @return None
+ */
+void LibCCEC::getRxStats(RxStats &stats)
+{
+	Driver::getInstance().getRxStats(stats);
+}
 CCEC_END_NAMESPACE
 
 
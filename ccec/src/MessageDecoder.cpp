@@ -26,6 +26,7 @@
 **/
 
 #include "ccec/CECFrame.hpp"
+#include "ccec/CECFrameView.hpp"
 #include "ccec/Header.hpp"
 #include "ccec/Operand.hpp"
 #include "ccec/Operands.hpp"
@@ -33,172 +34,278 @@
 #include "ccec/MessageDecoder.hpp"
 #include "ccec/Exception.hpp"
 #include "ccec/Util.hpp" 
+#include <stdio.h>
+#include <atomic>
 #include <telemetry_busmessage_sender.h>
 
 CCEC_BEGIN_NAMESPACE
 
+namespace {
+
+typedef MessageDecoder::Status (*Thunk)(MessageProcessor &processor, const CECFrameView &operands, const Header &header);
+
+/*
+ * An exception while the message is built means a malformed operand; one from
+ * the processor is passed on to tryDecode().
+ */
+template <class M>
+MessageDecoder::Status decodeAndProcess(MessageProcessor &processor, const CECFrameView &operands, const Header &header)
+{
+	bool built = false;
+
+	try {
+		M message(operands);
+		built = true;
+		processor.process(message, header);
+	}
+	catch (...) {
+		if (!built) {
+			return MessageDecoder::DECODE_INVALID_OPERAND;
+		}
+		throw;
+	}
+	return MessageDecoder::DECODE_OK;
+}
+
+template <class M>
+MessageDecoder::Status process(MessageProcessor &processor, const CECFrameView &operands, const Header &header)
+{
+	processor.process(M(), header);
+	return MessageDecoder::DECODE_OK;
+}
+
+/* Built-in decoding, indexed by opcode. NULL for opcodes the library does not decode */
+struct DispatchTable {
+	DispatchTable(void) {
+		for (size_t i = 0; i < sizeof(thunks) / sizeof(thunks[0]); i++) {
+			thunks[i] = NULL;
+		}
+		thunks[ACTIVE_SOURCE]                  = decodeAndProcess<ActiveSource>;
+		thunks[INACTIVE_SOURCE]                = decodeAndProcess<InActiveSource>;
+		thunks[IMAGE_VIEW_ON]                  = process<ImageViewOn>;
+		thunks[TEXT_VIEW_ON]                   = process<TextViewOn>;
+		thunks[REQUEST_ACTIVE_SOURCE]          = process<RequestActiveSource>;
+		thunks[STANDBY]                        = process<Standby>;
+		thunks[GET_CEC_VERSION]                = process<GetCECVersion>;
+		thunks[CEC_VERSION]                    = decodeAndProcess<CECVersion>;
+		thunks[SET_MENU_LANGUAGE]              = decodeAndProcess<SetMenuLanguage>;
+		thunks[GIVE_OSD_NAME]                  = process<GiveOSDName>;
+		thunks[GIVE_PHYSICAL_ADDRESS]          = process<GivePhysicalAddress>;
+		thunks[REPORT_PHYSICAL_ADDRESS]        = decodeAndProcess<ReportPhysicalAddress>;
+		thunks[GIVE_DEVICE_VENDOR_ID]          = process<GiveDeviceVendorID>;
+		thunks[ROUTING_CHANGE]                 = decodeAndProcess<RoutingChange>;
+		thunks[ROUTING_INFORMATION]            = decodeAndProcess<RoutingInformation>;
+		thunks[SET_STREAM_PATH]                = decodeAndProcess<SetStreamPath>;
+		thunks[GET_MENU_LANGUAGE]              = process<GetMenuLanguage>;
+		thunks[DEVICE_VENDOR_ID]               = decodeAndProcess<DeviceVendorID>;
+		thunks[SET_OSD_STRING]                 = decodeAndProcess<SetOSDString>;
+		thunks[SET_OSD_NAME]                   = decodeAndProcess<SetOSDName>;
+		thunks[USER_CONTROL_RELEASED]          = process<UserControlReleased>;
+		thunks[USER_CONTROL_PRESSED]           = decodeAndProcess<UserControlPressed>;
+		thunks[GIVE_DEVICE_POWER_STATUS]       = process<GiveDevicePowerStatus>;
+		thunks[REPORT_POWER_STATUS]            = decodeAndProcess<ReportPowerStatus>;
+		thunks[FEATURE_ABORT]                  = decodeAndProcess<FeatureAbort>;
+		thunks[ABORT]                          = process<Abort>;
+		thunks[INITIATE_ARC]                   = process<InitiateArc>;
+		thunks[TERMINATE_ARC]                  = process<TerminateArc>;
+		thunks[REQUEST_SHORT_AUDIO_DESCRIPTOR] = decodeAndProcess<RequestShortAudioDescriptor>;
+		thunks[REPORT_SHORT_AUDIO_DESCRIPTOR]  = decodeAndProcess<ReportShortAudioDescriptor>;
+		thunks[SYSTEM_AUDIO_MODE_REQUEST]      = decodeAndProcess<SystemAudioModeRequest>;
+		thunks[SET_SYSTEM_AUDIO_MODE]          = decodeAndProcess<SetSystemAudioMode>;
+		thunks[REPORT_AUDIO_STATUS]            = decodeAndProcess<ReportAudioStatus>;
+		thunks[GIVE_FEATURES]                  = process<GiveFeatures>;
+		thunks[REPORT_FEATURES]                = decodeAndProcess<ReportFeatures>;
+		thunks[REQUEST_CURRENT_LATENCY]        = decodeAndProcess<RequestCurrentLatency>;
+		thunks[REPORT_CURRENT_LATENCY]         = decodeAndProcess<ReportCurrentLatency>;
+	}
+
+	Thunk thunks[256];
+};
+
+const DispatchTable & dispatchTable(void)
+{
+	static const DispatchTable table;
+	return table;
+}
+
+/* Application handlers registered through MessageDecoder::registerHandler() */
+std::atomic<OpCodeHandler *> handlers[256];
+
+/* Number of frames per decode status, for all decoders of the process */
+std::atomic<size_t> counts[MessageDecoder::DECODE_STATUS_MAX];
+
+enum {
+	REPORT_INTERVAL_SECS = 30,
+};
+
+/* Counts at the last summary, and when it was sent */
+std::atomic<size_t> reported[MessageDecoder::DECODE_STATUS_MAX];
+std::atomic<uint64_t> lastReportUs(0);
+
+size_t delta(MessageDecoder::Status status)
+{
+	size_t count = counts[status].load(std::memory_order_relaxed);
+	return count - reported[status].exchange(count, std::memory_order_relaxed);
+}
+
+/*
+ * Sends at most one summary of rejected frames per REPORT_INTERVAL_SECS, from
+ * whichever thread rejects a frame once the interval is up. A burst of
+ * malformed frames costs the reader no more than a counter increment and a
+ * clock read each.
+ */
+void report(void)
+{
+	uint64_t now = GetMonotonicTimeUs();
+	uint64_t last = lastReportUs.load(std::memory_order_relaxed);
+
+	if (last != 0 && now - last < (uint64_t)REPORT_INTERVAL_SECS * 1000000) {
+		return;
+	}
+	if (!lastReportUs.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+		/* Another thread is reporting */
+		return;
+	}
+
+	size_t length     = delta(MessageDecoder::DECODE_INVALID_LENGTH);
+	size_t addressing = delta(MessageDecoder::DECODE_INVALID_ADDRESSING);
+	size_t process    = delta(MessageDecoder::DECODE_PROCESS_ERROR);
+	size_t operand    = delta(MessageDecoder::DECODE_INVALID_OPERAND);
+
+	if (length + addressing + process + operand == 0) {
+		return;
+	}
+
+	char buffer[160];
+	snprintf(buffer, sizeof(buffer), "MessageDecoder rejected %zu frames (length %zu, addressing %zu, operand %zu, process %zu)",
+			 length + addressing + process + operand, length, addressing, operand, process);
+	t2_event_s("SYST_ERR_CECBusEx", buffer);
+	CCEC_LOG( LOG_WARN, "%s \r\n", buffer);
+}
+
+MessageDecoder::Status record(MessageDecoder::Status status)
+{
+	counts[status].fetch_add(1, std::memory_order_relaxed);
+
+	if (status >= MessageDecoder::DECODE_INVALID_LENGTH) {
+		report();
+	}
+
+	return status;
+}
+
+}
+
+void MessageDecoder::registerHandler(Op_t opCode, OpCodeHandler *handler)
+{
+	if (opCode >= sizeof(handlers) / sizeof(handlers[0])) {
+		throw InvalidParamException();
+	}
+
+	handlers[opCode].store(handler, std::memory_order_release);
+}
+
+/**
+ * @brief Returns how many frames ended with the given decode status, summed over
+ * all decoders of the process.
+ *
+ * @param[in] status Decode status.
+ *
+ * @return Number of frames.
+ */
+size_t MessageDecoder::getCount(Status status)
+{
+	if (status < DECODE_OK || status >= DECODE_STATUS_MAX) {
+		return 0;
+	}
+
+	return counts[status].load(std::memory_order_relaxed);
+}
+
 void MessageDecoder::decode(const CECFrame &in_)
+{
+	(void) tryDecode(in_);
+}
+
+/**
+ * @brief Decodes a frame and hands the message to the processor, or to the handler
+ * registered for its opcode. Frames with a bad length or addressing are rejected
+ * before any operand is built, so no exception is raised for them. An operand
+ * value that fails its own checks ends as DECODE_INVALID_OPERAND, not as a
+ * processor error.
+ *
+ * @param[in] in_ Frame received from the bus.
+ *
+ * @return DECODE_OK if the message was processed, otherwise the reason it was not.
+ */
+MessageDecoder::Status MessageDecoder::tryDecode(const CECFrame &in_) noexcept
 {
     const int HEADER_OFFSET = 0;
     const int OPCODE_OFFSET = 1;
     const int OPRAND_OFFSET = 2;
 
+	if (in_.length() == 0) {
+		return record(DECODE_INVALID_LENGTH);
+	}
+
 	Header header(in_, HEADER_OFFSET);
 
-    if (in_.length() == 1) {
-    	/* This is an Polling Message */
-    	processor.process(Polling(), header);
-    	return;
-    }
-
-	CECFrame in = in_.subFrame(OPRAND_OFFSET);
-
-    try
-    {
-	switch (OpCode(in_, OPCODE_OFFSET).opCode()) {
-	case ACTIVE_SOURCE:
-		processor.process(ActiveSource(in), header);
-		break;
-	case INACTIVE_SOURCE:
-		processor.process(InActiveSource(in), header);
-		break;
-	case IMAGE_VIEW_ON:
-		processor.process(ImageViewOn(), header);
-		break;
-	case TEXT_VIEW_ON:
-		processor.process(TextViewOn(), header);
-		break;
-	case REQUEST_ACTIVE_SOURCE:
-		processor.process(RequestActiveSource(), header);
-		break;
-	case STANDBY:
-		CCEC_LOG( LOG_DEBUG, "Decoding STANDBY\r\n");
-		processor.process(Standby(), header);
-		break;
-	case GET_CEC_VERSION:
-		processor.process(GetCECVersion(), header);
-		break;
-	case CEC_VERSION:
-		processor.process(CECVersion(in), header);
-		break;
-	case SET_MENU_LANGUAGE:
-		processor.process(SetMenuLanguage(in), header);
-		break;
-	case GIVE_OSD_NAME:
-		processor.process(GiveOSDName(), header);
-		break;
-	case GIVE_PHYSICAL_ADDRESS:
-		processor.process(GivePhysicalAddress(), header);
-		break;
-	case REPORT_PHYSICAL_ADDRESS:
-		processor.process(ReportPhysicalAddress(in), header);
-		break;
-	case GIVE_DEVICE_VENDOR_ID:
-		processor.process(GiveDeviceVendorID(), header);
-		break;
-	case ROUTING_CHANGE:
-		processor.process(RoutingChange(in), header);
-		break;
-	case ROUTING_INFORMATION:
-		processor.process(RoutingInformation(in), header);
-		break;
-	case SET_STREAM_PATH:
-		processor.process(SetStreamPath(in), header);
-		break;
-	case GET_MENU_LANGUAGE:
-		processor.process(GetMenuLanguage(), header);
-		break;
-	case DEVICE_VENDOR_ID:
-		processor.process(DeviceVendorID(in), header);
-		break;
-	case VENDOR_COMMAND:
-		//processor.process(VendorCommand(in), header);
-		break;
-	case VENDOR_COMMAND_WITH_ID:
-		//processor.process(VendorCommandWithID(in), header);
-		break;
-	case VENDOR_REMOTE_BUTTON_DOWN:
-		//processor.process(VendorRemoteButtonDown(in), header);
-		break;
-	case VENDOR_REMOTE_BUTTON_UP:
-		//processor.process(VendorRemoteButtonUp(in), header);
-		break;
-	case SET_OSD_STRING:
-		processor.process(SetOSDString(in), header);
-		break;
-	case SET_OSD_NAME:
-		processor.process(SetOSDName(in), header);
-		break;
-	case USER_CONTROL_RELEASED:
-		processor.process(UserControlReleased(), header);
-		break;
-	case USER_CONTROL_PRESSED:
-		processor.process(UserControlPressed(in), header);
-		break;
-	case GIVE_DEVICE_POWER_STATUS:
-		processor.process(GiveDevicePowerStatus(), header);
-		break;
-	case REPORT_POWER_STATUS:
-		processor.process(ReportPowerStatus(in), header);
-		break;
-	case FEATURE_ABORT:
-		processor.process(FeatureAbort(in), header);
-		break;
-	case ABORT:
-		processor.process(Abort(), header);
-		break;
-        case INITIATE_ARC:
-             processor.process(InitiateArc(), header);
-                break;
-       case TERMINATE_ARC:
-             processor.process(TerminateArc(), header);
-             break;
-	 case REQUEST_SHORT_AUDIO_DESCRIPTOR:
-             processor.process(RequestShortAudioDescriptor(in), header);
-             break;
-
-	case REPORT_SHORT_AUDIO_DESCRIPTOR:
-	     processor.process(ReportShortAudioDescriptor(in), header);
-	     break;
-	case SYSTEM_AUDIO_MODE_REQUEST:
-             processor.process(SystemAudioModeRequest(in), header);
-             break;
-        case SET_SYSTEM_AUDIO_MODE:
-             processor.process(SetSystemAudioMode(in), header);
-             break;
-	case REPORT_AUDIO_STATUS :
-	     processor.process(ReportAudioStatus(in), header);
-             break;
-	case GIVE_FEATURES :
-             processor.process(GiveFeatures(), header);
-             break;
-        case REPORT_FEATURES :
-             processor.process(ReportFeatures(in), header);
-             break;
-	case REQUEST_CURRENT_LATENCY :
-             processor.process(RequestCurrentLatency(in), header);
-             break;
-	case REPORT_CURRENT_LATENCY :
-             processor.process(ReportCurrentLatency(in), header);
-             break;
-	default:
-        CCEC_LOG( LOG_DEBUG, "Unhandled Message Received \n");
-        OpCode(in_, OPCODE_OFFSET).print();
-		break;
-	}
-    }
-    catch(InvalidParamException &e)
-    {
-	char buffer[128];
-        snprintf(buffer, 128, "MessageDecoder::decode caught %s", e.what());
-        t2_event_s("SYST_ERR_CECBusEx",buffer);
-        CCEC_LOG( LOG_EXP, "MessageDecoder::decode caught %s \r\n",e.what());
-    }
-    catch(std::exception &e)
-    {
-	CCEC_LOG( LOG_EXP, "MessageDecoder::decode caught an %s \r\n",e.what());
-        in_.hexDump(LOG_EXP);
-    }
+	if (in_.length() == 1) {
+		/* This is an Polling Message */
+		try {
+			processor.process(Polling(), header);
+		}
+		catch (...) {
+			return record(DECODE_PROCESS_ERROR);
+		}
+		return record(DECODE_OK);
+	}
+
+	uint8_t opCode = in_.at(OPCODE_OFFSET);
+	OpCodeHandler *handler = handlers[opCode].load(std::memory_order_acquire);
+
+	if (handler == NULL && !processor.isInterested(opCode)) {
+		return record(DECODE_IGNORED);
+	}
+
+	/* Reject bad lengths and addressing before any operand is built */
+	if (in_.length() - OPRAND_OFFSET < GetOpCodeInfo(opCode).minOperandLength) {
+		return record(DECODE_INVALID_LENGTH);
+	}
+	if (!IsValidFrame(in_)) {
+		return record(DECODE_INVALID_ADDRESSING);
+	}
+
+	/* Operands are decoded in place; no bytes are copied out of the frame */
+	CECFrameView in(in_, OPRAND_OFFSET);
+	Thunk thunk = dispatchTable().thunks[opCode];
+
+	try {
+		if (handler != NULL) {
+			handler->process(in, header);
+		}
+		else if (thunk != NULL) {
+			Status status = thunk(processor, in, header);
+			if (status != DECODE_OK) {
+				CCEC_LOG( LOG_DEBUG, "MessageDecoder::tryDecode malformed operand in opcode %x \r\n", opCode);
+				return record(status);
+			}
+		}
+		else {
+			CCEC_LOG( LOG_DEBUG, "Unhandled Message Received \n");
+			OpCode(in_, OPCODE_OFFSET).print();
+			return record(DECODE_UNHANDLED);
+		}
+	}
+	catch (std::exception &e) {
+		CCEC_LOG( LOG_DEBUG, "MessageDecoder::tryDecode caught %s \r\n", e.what());
+		return record(DECODE_PROCESS_ERROR);
+	}
+	catch (...) {
+		return record(DECODE_PROCESS_ERROR);
+	}
+
+	return record(DECODE_OK);
 }
 
 CCEC_END_NAMESPACE
@@ -35,236 +35,304 @@ CCEC_BEGIN_NAMESPACE
 
 extern "C" const char *GetOpName(Op_t op);
 
+#define UNRECOGNIZED {"Unrecognized Message", 0, CECFrame::MAX_LENGTH - 2, OPCODE_DIRECTED | OPCODE_BROADCAST, UNKNOWN}
+
+/* Indexed by opcode: name, min and max operand length, addressing, expected response */
+static constexpr OpCodeInfo opCodeTable[256] = {
+	/* 0x00 */ {"Feature Abort", 2, 2, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x01 */ UNRECOGNIZED,
+	/* 0x02 */ UNRECOGNIZED,
+	/* 0x03 */ UNRECOGNIZED,
+	/* 0x04 */ {"Image View On", 0, 0, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x05 */ {"Tuner Step Increment", 0, 0, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x06 */ {"Tuner Step Decrement", 0, 0, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x07 */ {"Tuner Device Status", 5, 8, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x08 */ {"Give Tuner Device Status", 1, 1, OPCODE_DIRECTED, TUNER_DEVICE_STATUS},
+	/* 0x09 */ {" Record On", 1, 8, OPCODE_DIRECTED, RECORD_STATUS},
+	/* 0x0A */ {"Record Status", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x0B */ {"Record Off", 0, 0, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x0C */ UNRECOGNIZED,
+	/* 0x0D */ {"Text View On", 0, 0, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x0E */ UNRECOGNIZED,
+	/* 0x0F */ {"Record TV Screen", 0, 0, OPCODE_DIRECTED, RECORD_ON},
+	/* 0x10 */ UNRECOGNIZED,
+	/* 0x11 */ UNRECOGNIZED,
+	/* 0x12 */ UNRECOGNIZED,
+	/* 0x13 */ UNRECOGNIZED,
+	/* 0x14 */ UNRECOGNIZED,
+	/* 0x15 */ UNRECOGNIZED,
+	/* 0x16 */ UNRECOGNIZED,
+	/* 0x17 */ UNRECOGNIZED,
+	/* 0x18 */ UNRECOGNIZED,
+	/* 0x19 */ UNRECOGNIZED,
+	/* 0x1A */ {"Give Deck Status", 1, 1, OPCODE_DIRECTED, DECK_STATUS},
+	/* 0x1B */ {"deck Status", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x1C */ UNRECOGNIZED,
+	/* 0x1D */ UNRECOGNIZED,
+	/* 0x1E */ UNRECOGNIZED,
+	/* 0x1F */ UNRECOGNIZED,
+	/* 0x20 */ UNRECOGNIZED,
+	/* 0x21 */ UNRECOGNIZED,
+	/* 0x22 */ UNRECOGNIZED,
+	/* 0x23 */ UNRECOGNIZED,
+	/* 0x24 */ UNRECOGNIZED,
+	/* 0x25 */ UNRECOGNIZED,
+	/* 0x26 */ UNRECOGNIZED,
+	/* 0x27 */ UNRECOGNIZED,
+	/* 0x28 */ UNRECOGNIZED,
+	/* 0x29 */ UNRECOGNIZED,
+	/* 0x2A */ UNRECOGNIZED,
+	/* 0x2B */ UNRECOGNIZED,
+	/* 0x2C */ UNRECOGNIZED,
+	/* 0x2D */ UNRECOGNIZED,
+	/* 0x2E */ UNRECOGNIZED,
+	/* 0x2F */ UNRECOGNIZED,
+	/* 0x30 */ UNRECOGNIZED,
+	/* 0x31 */ UNRECOGNIZED,
+	/* 0x32 */ {"Set Menu Language", 3, 3, OPCODE_BROADCAST, UNKNOWN},
+	/* 0x33 */ {"Clear Analogue Timer", 11, 11, OPCODE_DIRECTED, TIMER_CLEARED_STATUS},
+	/* 0x34 */ {"Set Analog Timer", 11, 11, OPCODE_DIRECTED, TIMER_STATUS},
+	/* 0x35 */ {"Timer Status", 1, 3, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x36 */ {"Stand by", 0, 0, OPCODE_DIRECTED | OPCODE_BROADCAST, UNKNOWN},
+	/* 0x37 */ UNRECOGNIZED,
+	/* 0x38 */ UNRECOGNIZED,
+	/* 0x39 */ UNRECOGNIZED,
+	/* 0x3A */ UNRECOGNIZED,
+	/* 0x3B */ UNRECOGNIZED,
+	/* 0x3C */ UNRECOGNIZED,
+	/* 0x3D */ UNRECOGNIZED,
+	/* 0x3E */ UNRECOGNIZED,
+	/* 0x3F */ UNRECOGNIZED,
+	/* 0x40 */ UNRECOGNIZED,
+	/* 0x41 */ {"Play", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x42 */ {"Deck control", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x43 */ {"Timer Cleared Status", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x44 */ {"User control Pressed", 1, 4, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x45 */ {"User Control released", 0, 0, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x46 */ {"Give OSD Name", 0, 0, OPCODE_DIRECTED, SET_OSD_NAME},
+	/* 0x47 */ {"Set OSD Name", 1, 14, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x48 */ UNRECOGNIZED,
+	/* 0x49 */ UNRECOGNIZED,
+	/* 0x4A */ UNRECOGNIZED,
+	/* 0x4B */ UNRECOGNIZED,
+	/* 0x4C */ UNRECOGNIZED,
+	/* 0x4D */ UNRECOGNIZED,
+	/* 0x4E */ UNRECOGNIZED,
+	/* 0x4F */ UNRECOGNIZED,
+	/* 0x50 */ UNRECOGNIZED,
+	/* 0x51 */ UNRECOGNIZED,
+	/* 0x52 */ UNRECOGNIZED,
+	/* 0x53 */ UNRECOGNIZED,
+	/* 0x54 */ UNRECOGNIZED,
+	/* 0x55 */ UNRECOGNIZED,
+	/* 0x56 */ UNRECOGNIZED,
+	/* 0x57 */ UNRECOGNIZED,
+	/* 0x58 */ UNRECOGNIZED,
+	/* 0x59 */ UNRECOGNIZED,
+	/* 0x5A */ UNRECOGNIZED,
+	/* 0x5B */ UNRECOGNIZED,
+	/* 0x5C */ UNRECOGNIZED,
+	/* 0x5D */ UNRECOGNIZED,
+	/* 0x5E */ UNRECOGNIZED,
+	/* 0x5F */ UNRECOGNIZED,
+	/* 0x60 */ UNRECOGNIZED,
+	/* 0x61 */ UNRECOGNIZED,
+	/* 0x62 */ UNRECOGNIZED,
+	/* 0x63 */ UNRECOGNIZED,
+	/* 0x64 */ {"Set OSD String", 2, 14, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x65 */ UNRECOGNIZED,
+	/* 0x66 */ UNRECOGNIZED,
+	/* 0x67 */ {"Set Timer Program Title", 1, 14, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x68 */ UNRECOGNIZED,
+	/* 0x69 */ UNRECOGNIZED,
+	/* 0x6A */ UNRECOGNIZED,
+	/* 0x6B */ UNRECOGNIZED,
+	/* 0x6C */ UNRECOGNIZED,
+	/* 0x6D */ UNRECOGNIZED,
+	/* 0x6E */ UNRECOGNIZED,
+	/* 0x6F */ UNRECOGNIZED,
+	/* 0x70 */ {"System Audio mode request", 0, 2, OPCODE_DIRECTED, SET_SYSTEM_AUDIO_MODE},
+	/* 0x71 */ {"Give Aduio Status", 0, 0, OPCODE_DIRECTED, REPORT_AUDIO_STATUS},
+	/* 0x72 */ {"Set System Audio Mode", 1, 1, OPCODE_DIRECTED | OPCODE_BROADCAST, UNKNOWN},
+	/* 0x73 */ UNRECOGNIZED,
+	/* 0x74 */ UNRECOGNIZED,
+	/* 0x75 */ UNRECOGNIZED,
+	/* 0x76 */ UNRECOGNIZED,
+	/* 0x77 */ UNRECOGNIZED,
+	/* 0x78 */ UNRECOGNIZED,
+	/* 0x79 */ UNRECOGNIZED,
+	/* 0x7A */ {"Report Audio Status", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x7B */ UNRECOGNIZED,
+	/* 0x7C */ UNRECOGNIZED,
+	/* 0x7D */ {"Give System Audio Mode Status", 0, 0, OPCODE_DIRECTED, SYSTEM_AUDIO_MODE_STATUS},
+	/* 0x7E */ {"System Audio Mode Status", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x7F */ UNRECOGNIZED,
+	/* 0x80 */ {"Routing Change", 4, 4, OPCODE_BROADCAST, UNKNOWN},
+	/* 0x81 */ {"Routing Information", 2, 2, OPCODE_BROADCAST, UNKNOWN},
+	/* 0x82 */ {"Active Source", 2, 2, OPCODE_BROADCAST, UNKNOWN},
+	/* 0x83 */ {"Give Physical Address", 0, 0, OPCODE_DIRECTED, REPORT_PHYSICAL_ADDRESS},
+	/* 0x84 */ {"Report Physical Address", 3, 3, OPCODE_BROADCAST, UNKNOWN},
+	/* 0x85 */ {"Request Active Source", 0, 0, OPCODE_BROADCAST, ACTIVE_SOURCE},
+	/* 0x86 */ {"Set Stream Path", 2, 2, OPCODE_BROADCAST, UNKNOWN},
+	/* 0x87 */ {"Device Vendor Id", 3, 3, OPCODE_BROADCAST, UNKNOWN},
+	/* 0x88 */ UNRECOGNIZED,
+	/* 0x89 */ {"Vendor Command", 1, 14, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x8A */ {"Vendor Remote Button Down", 1, 14, OPCODE_DIRECTED | OPCODE_BROADCAST, UNKNOWN},
+	/* 0x8B */ {"Vendor Remote Button Up", 0, 14, OPCODE_DIRECTED | OPCODE_BROADCAST, UNKNOWN},
+	/* 0x8C */ {"Give Ddevice Vendor ID", 0, 0, OPCODE_DIRECTED, DEVICE_VENDOR_ID},
+	/* 0x8D */ {"Menu Request", 1, 1, OPCODE_DIRECTED, MENU_STATUS},
+	/* 0x8E */ {"Menu Status", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x8F */ {"Give Device Power Status", 0, 0, OPCODE_DIRECTED, REPORT_POWER_STATUS},
+	/* 0x90 */ {"Report power Status", 1, 1, OPCODE_DIRECTED | OPCODE_BROADCAST, UNKNOWN},
+	/* 0x91 */ {"Get Menu Language", 0, 0, OPCODE_DIRECTED, SET_MENU_LANGUAGE},
+	/* 0x92 */ {"Select Analogue service", 4, 4, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x93 */ {"Select Digital Service", 7, 7, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x94 */ UNRECOGNIZED,
+	/* 0x95 */ UNRECOGNIZED,
+	/* 0x96 */ UNRECOGNIZED,
+	/* 0x97 */ {" Set Digital Timer", 14, 14, OPCODE_DIRECTED, TIMER_STATUS},
+	/* 0x98 */ UNRECOGNIZED,
+	/* 0x99 */ {"Clear Digital Timer", 14, 14, OPCODE_DIRECTED, TIMER_CLEARED_STATUS},
+	/* 0x9A */ {"Set Audio rate", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x9B */ UNRECOGNIZED,
+	/* 0x9C */ UNRECOGNIZED,
+	/* 0x9D */ {"InActive Source", 2, 2, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x9E */ {"CEC Version", 1, 1, OPCODE_DIRECTED, UNKNOWN},
+	/* 0x9F */ {"Get CEC Version", 0, 0, OPCODE_DIRECTED, CEC_VERSION},
+	/* 0xA0 */ {"Vendor command With ID", 3, 14, OPCODE_DIRECTED | OPCODE_BROADCAST, UNKNOWN},
+	/* 0xA1 */ {"Clear External Timer", 9, 10, OPCODE_DIRECTED, TIMER_CLEARED_STATUS},
+	/* 0xA2 */ {"Set External Timer", 9, 10, OPCODE_DIRECTED, TIMER_STATUS},
+	/* 0xA3 */ {"Report Short Audio Descriptor", 3, 12, OPCODE_DIRECTED, UNKNOWN},
+	/* 0xA4 */ {"Request Short Audio Descriptor", 1, 4, OPCODE_DIRECTED, REPORT_SHORT_AUDIO_DESCRIPTOR},
+	/* 0xA5 */ {"Give Features", 0, 0, OPCODE_DIRECTED, REPORT_FEATURES},
+	/* 0xA6 */ {"Report Features", 4, 14, OPCODE_BROADCAST, UNKNOWN},
+	/* 0xA7 */ {"Request Current Latency", 2, 2, OPCODE_BROADCAST, REPORT_CURRENT_LATENCY},
+	/* 0xA8 */ {"Report Current Latency", 4, 5, OPCODE_BROADCAST, UNKNOWN},
+	/* 0xA9 */ UNRECOGNIZED,
+	/* 0xAA */ UNRECOGNIZED,
+	/* 0xAB */ UNRECOGNIZED,
+	/* 0xAC */ UNRECOGNIZED,
+	/* 0xAD */ UNRECOGNIZED,
+	/* 0xAE */ UNRECOGNIZED,
+	/* 0xAF */ UNRECOGNIZED,
+	/* 0xB0 */ UNRECOGNIZED,
+	/* 0xB1 */ UNRECOGNIZED,
+	/* 0xB2 */ UNRECOGNIZED,
+	/* 0xB3 */ UNRECOGNIZED,
+	/* 0xB4 */ UNRECOGNIZED,
+	/* 0xB5 */ UNRECOGNIZED,
+	/* 0xB6 */ UNRECOGNIZED,
+	/* 0xB7 */ UNRECOGNIZED,
+	/* 0xB8 */ UNRECOGNIZED,
+	/* 0xB9 */ UNRECOGNIZED,
+	/* 0xBA */ UNRECOGNIZED,
+	/* 0xBB */ UNRECOGNIZED,
+	/* 0xBC */ UNRECOGNIZED,
+	/* 0xBD */ UNRECOGNIZED,
+	/* 0xBE */ UNRECOGNIZED,
+	/* 0xBF */ UNRECOGNIZED,
+	/* 0xC0 */ {"Initiate ARC", 0, 0, OPCODE_DIRECTED, REPORT_ARC_INITIATED},
+	/* 0xC1 */ {"Report ARC Initiated", 0, 0, OPCODE_DIRECTED, UNKNOWN},
+	/* 0xC2 */ {"Report ARC Terminated", 0, 0, OPCODE_DIRECTED, UNKNOWN},
+	/* 0xC3 */ {"Report ARC Initiation", 0, 0, OPCODE_DIRECTED, INITIATE_ARC},
+	/* 0xC4 */ {"Request ARC Termination", 0, 0, OPCODE_DIRECTED, TERMINATE_ARC},
+	/* 0xC5 */ {"Terminate ARC", 0, 0, OPCODE_DIRECTED, REPORT_ARC_TERMINATED},
+	/* 0xC6 */ UNRECOGNIZED,
+	/* 0xC7 */ UNRECOGNIZED,
+	/* 0xC8 */ UNRECOGNIZED,
+	/* 0xC9 */ UNRECOGNIZED,
+	/* 0xCA */ UNRECOGNIZED,
+	/* 0xCB */ UNRECOGNIZED,
+	/* 0xCC */ UNRECOGNIZED,
+	/* 0xCD */ UNRECOGNIZED,
+	/* 0xCE */ UNRECOGNIZED,
+	/* 0xCF */ UNRECOGNIZED,
+	/* 0xD0 */ UNRECOGNIZED,
+	/* 0xD1 */ UNRECOGNIZED,
+	/* 0xD2 */ UNRECOGNIZED,
+	/* 0xD3 */ UNRECOGNIZED,
+	/* 0xD4 */ UNRECOGNIZED,
+	/* 0xD5 */ UNRECOGNIZED,
+	/* 0xD6 */ UNRECOGNIZED,
+	/* 0xD7 */ UNRECOGNIZED,
+	/* 0xD8 */ UNRECOGNIZED,
+	/* 0xD9 */ UNRECOGNIZED,
+	/* 0xDA */ UNRECOGNIZED,
+	/* 0xDB */ UNRECOGNIZED,
+	/* 0xDC */ UNRECOGNIZED,
+	/* 0xDD */ UNRECOGNIZED,
+	/* 0xDE */ UNRECOGNIZED,
+	/* 0xDF */ UNRECOGNIZED,
+	/* 0xE0 */ UNRECOGNIZED,
+	/* 0xE1 */ UNRECOGNIZED,
+	/* 0xE2 */ UNRECOGNIZED,
+	/* 0xE3 */ UNRECOGNIZED,
+	/* 0xE4 */ UNRECOGNIZED,
+	/* 0xE5 */ UNRECOGNIZED,
+	/* 0xE6 */ UNRECOGNIZED,
+	/* 0xE7 */ UNRECOGNIZED,
+	/* 0xE8 */ UNRECOGNIZED,
+	/* 0xE9 */ UNRECOGNIZED,
+	/* 0xEA */ UNRECOGNIZED,
+	/* 0xEB */ UNRECOGNIZED,
+	/* 0xEC */ UNRECOGNIZED,
+	/* 0xED */ UNRECOGNIZED,
+	/* 0xEE */ UNRECOGNIZED,
+	/* 0xEF */ UNRECOGNIZED,
+	/* 0xF0 */ UNRECOGNIZED,
+	/* 0xF1 */ UNRECOGNIZED,
+	/* 0xF2 */ UNRECOGNIZED,
+	/* 0xF3 */ UNRECOGNIZED,
+	/* 0xF4 */ UNRECOGNIZED,
+	/* 0xF5 */ UNRECOGNIZED,
+	/* 0xF6 */ UNRECOGNIZED,
+	/* 0xF7 */ UNRECOGNIZED,
+	/* 0xF8 */ {"CDC Message", 3, 14, OPCODE_BROADCAST, UNKNOWN},
+	/* 0xF9 */ UNRECOGNIZED,
+	/* 0xFA */ UNRECOGNIZED,
+	/* 0xFB */ UNRECOGNIZED,
+	/* 0xFC */ UNRECOGNIZED,
+	/* 0xFD */ UNRECOGNIZED,
+	/* 0xFE */ UNRECOGNIZED,
+	/* 0xFF */ {"Abort", 0, 0, OPCODE_DIRECTED, FEATURE_ABORT},
+};
+
+static constexpr OpCodeInfo pollingInfo = {"Polling ", 0, 0, OPCODE_DIRECTED, UNKNOWN};
+static constexpr OpCodeInfo unrecognizedInfo = UNRECOGNIZED;
+
+#undef UNRECOGNIZED
+
+const OpCodeInfo & GetOpCodeInfo(Op_t op)
+{
+	if (op < sizeof(opCodeTable) / sizeof(opCodeTable[0])) {
+		return opCodeTable[op];
+	}
+
+	return (op == POLLING) ? pollingInfo : unrecognizedInfo;
+}
+
 const char *GetOpName(Op_t op)
 {
-	const char *name = NULL;
+	return GetOpCodeInfo(op).name;
+}
+
+bool IsValidFrame(const CECFrameView &frame)
+{
+	size_t len = frame.length();
+
+	if (len < 2) {
+		/* Header only: polling message */
+		return (len == 1);
+	}
+
+	const OpCodeInfo &info = GetOpCodeInfo(frame.at(1));
+	bool broadcast = ((frame.at(0) & 0x0F) == 0x0F);
 
-	switch(op) {
-	case ACTIVE_SOURCE:
-		name = "Active Source";
-		break;
-	case IMAGE_VIEW_ON:
-		name = "Image View On";
-		break;
-	case TEXT_VIEW_ON:
-		name = "Text View On";
-		break;
-	case INACTIVE_SOURCE:
-		name = "InActive Source";
-		break;
-	case REQUEST_ACTIVE_SOURCE:
-		name = "Request Active Source";
-		break;
-	case ROUTING_CHANGE:
-		name = "Routing Change";
-		break;
-	case ROUTING_INFORMATION:
-		name = "Routing Information";
-		break;
-	case SET_STREAM_PATH:
-		name = "Set Stream Path";
-		break;
-	case STANDBY:
-		name = "Stand by";
-		break;
-	case RECORD_OFF:
-		name = "Record Off";
-		break;
-	case RECORD_ON:
-		name = " Record On";
-		break;
-	case RECORD_STATUS:
-		name = "Record Status";
-		break;
-	case RECORD_TV_SCREEN:
-		name = "Record TV Screen";
-		break;
-	case CLEAR_ANALOGUE_TIMER:
-		name = "Clear Analogue Timer";
-		break;
-	case CLEAR_DIGITAL_TIMER:
-		name = "Clear Digital Timer";
-		break;
-	case CLEAR_EXTERNAL_TIMER:
-		name = "Clear External Timer";
-		break;
-	case SET_ANALOG_TIMER:
-		name = "Set Analog Timer";
-		break;
-	case SET_DIGITAL_TIMER:
-		name = " Set Digital Timer";
-		break;
-	case SET_EXTERNAL_TIMER:
-		name = "Set External Timer";
-		break;
-	case SET_TIMER_PROGRAM_TITLE:
-		name = "Set Timer Program Title";
-		break;
-	case TIMER_CLEARED_STATUS:
-		name = "Timer Cleared Status";
-		break;
-	case TIMER_STATUS:
-		name = "Timer Status";
-		break;
-	case CEC_VERSION:
-		name = "CEC Version";
-		break;
-	case GIVE_PHYSICAL_ADDRESS:
-		name = "Give Physical Address";
-		break;
-	case GET_MENU_LANGUAGE:
-		name = "Get Menu Language";
-		break;
-	case POLLING:
-		name = "Polling ";
-		break;
-	case REPORT_PHYSICAL_ADDRESS:
-		name = "Report Physical Address";
-		break;
-	case SET_MENU_LANGUAGE:
-		name = "Set Menu Language";
-		break;
-	case DECK_CONTROL:
-		name = "Deck control";
-		break;
-	case DECK_STATUS:
-		name = "deck Status";
-		break;
-	case PLAY:
-		name = "Play";
-		break;
-	case GIVE_TUNER_DEVICE_STATUS:
-		name = "Give Tuner Device Status";
-		break;
-	case SELECT_ANALOGUE_SERVICE:
-		name = "Select Analogue service";
-		break;
-	case TUNER_DEVICE_STATUS:
-		name = "Tuner Device Status";
-		break;
-	case TUNER_STEP_DECREMENT:
-		name = "Tuner Step Decrement";
-		break;
-	case TUNER_STEP_INCREMENT:
-		name = "Tuner Step Increment";
-		break;
-   	case DEVICE_VENDOR_ID:
-		name = "Device Vendor Id";
-		break;
-	case GET_CEC_VERSION:
-		name = "Get CEC Version";
-		break;
-	case GIVE_DEVICE_VENDOR_ID:
-		name = "Give Ddevice Vendor ID";
-		break;
-	case VENDOR_COMMAND:
-		name = "Vendor Command";
-		break;
-	case VENDOR_COMMAND_WITH_ID:
-		name = "Vendor command With ID";
-		break;
-	case VENDOR_REMOTE_BUTTON_DOWN:
-		name = "Vendor Remote Button Down";
-		break;
-	case VENDOR_REMOTE_BUTTON_UP:
-		name = "Vendor Remote Button Up";
-		break;
-	case SET_OSD_STRING:
-		name = "Set OSD String";
-		break;
-	case GIVE_OSD_NAME:
-		name = "Give OSD Name";
-		break;
-	case SET_OSD_NAME:
-		name = "Set OSD Name";
-		break;
-	case MENU_REQUEST:
-		name = "Menu Request";
-		break;
-	case MENU_STATUS:
-		name = "Menu Status";
-		break;
-	case USER_CONTROL_PRESSED:
-		name = "User control Pressed";
-		break;
-	case USER_CONTROL_RELEASED:
-		name = "User Control released";
-		break;
-	case GIVE_DEVICE_POWER_STATUS:
-		name = "Give Device Power Status";
-		break;
-	case REPORT_POWER_STATUS:
-		name = "Report power Status";
-		break;
-	case FEATURE_ABORT:
-		name = "Feature Abort";
-		break;
-	case ABORT:
-		name = "Abort";
-		break;
-	case GIVE_AUDIO_STATUS:
-		name = "Give Aduio Status";
-		break;
-	case GIVE_SYSTEM_AUDIO_MODE_STATUS:
-		name = "Give System Audio Mode Status";
-		break;
-	case REPORT_AUDIO_STATUS:
-		name = "Report Audio Status";
-		break;
-	case REQUEST_SHORT_AUDIO_DESCRIPTOR:
-		name = "Request Short Audio Descriptor";
-		break;
-	case REPORT_SHORT_AUDIO_DESCRIPTOR:
-		name = "Report Short Audio Descriptor";
-		break;
-	case SET_SYSTEM_AUDIO_MODE:
-		name = "Set System Audio Mode";
-		break;
-	case SYSTEM_AUDIO_MODE_REQUEST:
-		name = "System Audio mode request";
-		break;
-	case SET_AUDIO_RATE:
-		name = "Set Audio rate";
-		break;
-	case INITIATE_ARC:
-		name = "Initiate ARC";
-		break;
-	case REPORT_ARC_INITIATED:
-		name = "Report ARC Initiated";
-		break;
-	case REPORT_ARC_TERMINATED:
-		name = "Report ARC Terminated";
-		break;
-	case REQUEST_ARC_INITIATION:
-		name = "Report ARC Initiation";
-		break;
-	case REQUEST_ARC_TERMINATION:
-		name = "Request ARC Termination";
-		break;
-	case TERMINATE_ARC:
-		name = "Terminate ARC";
-		break;
-	case CDC_MESSAGE:
-		name = "CDC Message";
-		break;
-	case GIVE_FEATURES:
-                name = "Give Features";
-                break;
-        case REPORT_FEATURES:
-                name = "Report Features";
-                break;
-	case REQUEST_CURRENT_LATENCY:
-		name = "Request Current Latency";
-		break;
-	case REPORT_CURRENT_LATENCY:
-		name = "Report Current Latency";
-		break;
-	default:
-		name = "Unrecognized Message";
-		break;
+	if (len - 2 < info.minOperandLength) {
+		return false;
 	}
 
-	return name;
+	return (info.addressing & (broadcast ? OPCODE_BROADCAST : OPCODE_DIRECTED)) != 0;
 }
 
 CCEC_END_NAMESPACE
@@ -0,0 +1,304 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#include <string.h>
+
+#include "ccec/ResponseCache.hpp"
+#include "ccec/OpCode.hpp"
+#include "ccec/Util.hpp"
+
+using CCEC_OSAL::AutoLock;
+
+CCEC_BEGIN_NAMESPACE
+
+/*
+ * Host callbacks that were installed before the cache hooks were chained in.
+ * The hooks run on HAL threads, so each one is published on its own.
+ */
+static std::atomic<CECHost_HdmiHotplugCallback_t> chainedHotplugCb(NULL);
+static std::atomic<CECHost_PowerStateCallback_t> chainedPowerStateCb(NULL);
+static std::atomic<CECHost_OSDNameCallback_t> chainedOSDNameCb(NULL);
+
+/**
+ * @brief This function is used to get the process wide response cache.
+ *
+ * @return instance Instance of the ResponseCache class.
+ */
+ResponseCache & ResponseCache::getInstance(void)
+{
+	static ResponseCache instance;
+	return instance;
+}
+
+ResponseCache::ResponseCache(void)
+{
+	for (int index = 0; index < MAX_OPCODES; index++) {
+		generations[index].store(0);
+		for (int dest = 0; dest < MAX_DESTINATIONS; dest++) {
+			entries[index][dest].seq.store(0);
+			for (int i = 0; i < WORDS; i++) {
+				entries[index][dest].words[i].store(0);
+			}
+		}
+	}
+}
+
+int ResponseCache::indexOf(Op_t opCode)
+{
+	switch (opCode) {
+	case REPORT_PHYSICAL_ADDRESS:
+		return 0;
+	case DEVICE_VENDOR_ID:
+		return 1;
+	case SET_OSD_NAME:
+		return 2;
+	case CEC_VERSION:
+		return 3;
+	case REPORT_POWER_STATUS:
+		return 4;
+	default:
+		return -1;
+	}
+}
+
+/**
+ * @brief Checks whether replies with this opcode are kept by the cache.
+ *
+ * @param[in] opCode Opcode of the reply.
+ *
+ * @return true if the opcode is cacheable.
+ */
+bool ResponseCache::isCacheable(Op_t opCode)
+{
+	return indexOf(opCode) >= 0;
+}
+
+/**
+ * @brief Copies a cached reply into frame. Does not take a lock.
+ *
+ * The cached frame is only returned if it was encoded with the same initiator,
+ * so a change of logical address never sends a reply from the old address.
+ *
+ * @param[in] opCode Opcode of the reply.
+ * @param[in] from Initiator of the reply.
+ * @param[in] to Destination of the reply.
+ * @param[out] frame Encoded reply, ready to be sent.
+ *
+ * @return true on a cache hit, false if the reply has to be encoded.
+ */
+bool ResponseCache::get(Op_t opCode, const LogicalAddress &from, const LogicalAddress &to, CECFrame &frame) const
+{
+	int index = indexOf(opCode);
+	int dest = to.toInt();
+
+	if (index < 0 || dest < 0 || dest >= MAX_DESTINATIONS) {
+		return false;
+	}
+
+	const Entry &entry = entries[index][dest];
+	uint64_t words[WORDS];
+	uint32_t before, after;
+
+	do {
+		before = entry.seq.load(std::memory_order_acquire);
+		for (int i = 0; i < WORDS; i++) {
+			words[i] = entry.words[i].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		after = entry.seq.load(std::memory_order_relaxed);
+	} while ((before & 1) || before != after);
+
+	uint8_t bytes[WORDS * sizeof(uint64_t)];
+	memcpy(bytes, words, sizeof(bytes));
+
+	size_t len = bytes[0];
+	if (len < 2 || ((bytes[1] >> 4) & 0x0F) != (from.toInt() & 0x0F)) {
+		return false;
+	}
+
+	frame.reset();
+	frame.append(bytes + 1, len);
+	return true;
+}
+
+void ResponseCache::store(Entry &entry, const CECFrame *frame)
+{
+	uint8_t bytes[WORDS * sizeof(uint64_t)] = {0};
+	uint64_t words[WORDS];
+
+	if (frame != NULL) {
+		bytes[0] = (uint8_t)frame->length();
+		memcpy(bytes + 1, frame->getBuffer(), frame->length());
+	}
+	memcpy(words, bytes, sizeof(words));
+
+	uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+	entry.seq.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (int i = 0; i < WORDS; i++) {
+		entry.words[i].store(words[i], std::memory_order_relaxed);
+	}
+	entry.seq.store(seq + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Returns the invalidation generation of an opcode. Read it before
+ * encoding a reply from host state, and pass it to put().
+ *
+ * @param[in] opCode Opcode of the reply.
+ *
+ * @return Generation, or 0 for opcodes that are not cached.
+ */
+uint32_t ResponseCache::getGeneration(Op_t opCode) const
+{
+	int index = indexOf(opCode);
+	if (index < 0) {
+		return 0;
+	}
+
+	return generations[index].load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Stores an encoded reply. The opcode and destination are taken from the
+ * frame itself; frames with other opcodes are not stored.
+ *
+ * @param[in] frame Encoded reply.
+ * @param[in] generation getGeneration() of the opcode, read before the reply was
+ * encoded.
+ *
+ * @return true if the frame was stored, false if it is not cacheable or the
+ * opcode was invalidated since the generation was read.
+ */
+bool ResponseCache::put(const CECFrame &frame, uint32_t generation)
+{
+	if (frame.length() < 2) {
+		return false;
+	}
+
+	int index = indexOf(frame.at(1));
+	if (index < 0) {
+		return false;
+	}
+
+	{AutoLock lock_(mutex);
+		if (generations[index].load(std::memory_order_relaxed) != generation) {
+			/* Encoded from host state that has changed since */
+			return false;
+		}
+		store(entries[index][frame.at(0) & 0x0F], &frame);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Drops the cached replies with this opcode, for all destinations.
+ *
+ * @param[in] opCode Opcode of the replies.
+ */
+void ResponseCache::invalidate(Op_t opCode)
+{
+	int index = indexOf(opCode);
+	if (index < 0) {
+		return;
+	}
+
+	{AutoLock lock_(mutex);
+		generations[index].fetch_add(1, std::memory_order_release);
+		for (int dest = 0; dest < MAX_DESTINATIONS; dest++) {
+			store(entries[index][dest], NULL);
+		}
+	}
+}
+
+/**
+ * @brief Drops every cached reply.
+ */
+void ResponseCache::invalidateAll(void)
+{
+	AutoLock lock_(mutex);
+	for (int index = 0; index < MAX_OPCODES; index++) {
+		generations[index].fetch_add(1, std::memory_order_release);
+		for (int dest = 0; dest < MAX_DESTINATIONS; dest++) {
+			store(entries[index][dest], NULL);
+		}
+	}
+}
+
+/**
+ * @brief Returns a set of host callbacks that invalidate the cache and then call
+ * the given callbacks. Pass the result to CECHost_SetCallback() instead of the
+ * original set.
+ *
+ * @param[in] callbacks Callbacks the host module would otherwise install.
+ *
+ * @return Callbacks with the cache hooks chained in.
+ */
+CECHost_Callback_t ResponseCache::chainHostCallbacks(const CECHost_Callback_t &callbacks)
+{
+	CECHost_Callback_t chained = callbacks;
+
+	chainedHotplugCb.store(callbacks.hotplugCb, std::memory_order_release);
+	chainedPowerStateCb.store(callbacks.pwrStateCb, std::memory_order_release);
+	chainedOSDNameCb.store(callbacks.osdCb, std::memory_order_release);
+	chained.hotplugCb = onHotplug;
+	chained.pwrStateCb = onPowerState;
+	chained.osdCb = onOSDName;
+
+	return chained;
+}
+
+CECHost_Err_t ResponseCache::onHotplug(int32_t connect)
+{
+	CCEC_LOG( LOG_DEBUG, "ResponseCache: hotplug [%d], dropping all replies\r\n", connect);
+	getInstance().invalidateAll();
+	CECHost_HdmiHotplugCallback_t callback = chainedHotplugCb.load(std::memory_order_acquire);
+	return callback ? callback(connect) : CECHost_ERR_NONE;
+}
+
+CECHost_Err_t ResponseCache::onPowerState(int32_t curState, int32_t newState)
+{
+	getInstance().invalidate(REPORT_POWER_STATUS);
+	CECHost_PowerStateCallback_t callback = chainedPowerStateCb.load(std::memory_order_acquire);
+	return callback ? callback(curState, newState) : CECHost_ERR_NONE;
+}
+
+CECHost_Err_t ResponseCache::onOSDName(uint8_t *name, size_t len)
+{
+	getInstance().invalidate(SET_OSD_NAME);
+	CECHost_OSDNameCallback_t callback = chainedOSDNameCb.load(std::memory_order_acquire);
+	return callback ? callback(name, len) : CECHost_ERR_NONE;
+}
+
+CCEC_END_NAMESPACE
+
+
+/** @} */
+/** @} */
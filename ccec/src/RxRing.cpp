@@ -0,0 +1,184 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#include <errno.h>
+
+#include "RxRing.hpp"
+#include "ccec/Util.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+RxRing::RxRing(void) : head(0), tail(0), waiting(false), closed(true), epoch(0),
+                       frames(0), dropped(0), highWater(0), totalLatencyUs(0), maxLatencyUs(0)
+{
+	sem_init(&sem, 0, 0);
+}
+
+RxRing::~RxRing(void)
+{
+	sem_destroy(&sem);
+}
+
+/**
+ * @brief Copies a frame from the HAL into the next free slot and hands it to the
+ * reader. Called from the HAL callback thread only.
+ *
+ * @param[in] buf Frame bytes.
+ * @param[in] len Number of bytes, at most CECFrame::MAX_LENGTH.
+ *
+ * @return FALSE if the ring is full or closed and the frame was dropped.
+ */
+bool RxRing::push(const uint8_t *buf, size_t len)
+{
+	/* Read before closed, so that a close() and open() after this point always leave the frame stale */
+	uint32_t e = epoch.load(std::memory_order_acquire);
+	if (closed.load(std::memory_order_acquire)) {
+		return false;
+	}
+
+	uint32_t t = tail.load(std::memory_order_relaxed);
+	uint32_t queued = t - head.load(std::memory_order_acquire);
+	if (queued >= CAPACITY) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	Slot &slot = slots[t % CAPACITY];
+	slot.frame.reset();
+	slot.frame.append(buf, len);
+	slot.receivedUs = GetMonotonicTimeUs();
+	slot.epoch = e;
+
+	if (queued + 1 > highWater.load(std::memory_order_relaxed)) {
+		highWater.store(queued + 1, std::memory_order_relaxed);
+	}
+
+	/* Sequentially consistent, paired with the reader setting waiting before it checks tail */
+	tail.store(t + 1);
+	wake();
+	return true;
+}
+
+/**
+ * @brief Waits for the oldest frame. The frame stays in its slot, and valid,
+ * until pop(). Called from the reader thread only.
+ *
+ * @return The frame, or NULL once the ring is closed. Frames still queued at
+ * that point are discarded, and so is a frame that the callback publishes after
+ * it, even once the ring is open again.
+ */
+const CECFrame * RxRing::front(void)
+{
+	for (;;) {
+		uint32_t h = head.load(std::memory_order_relaxed);
+
+		if (closed.load(std::memory_order_acquire)) {
+			head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+			return NULL;
+		}
+
+		if (h != tail.load(std::memory_order_acquire)) {
+			Slot &slot = slots[h % CAPACITY];
+			if (slot.epoch != epoch.load(std::memory_order_acquire)) {
+				/* Received before the last close() */
+				head.store(h + 1, std::memory_order_release);
+				continue;
+			}
+
+			uint64_t latency = GetMonotonicTimeUs() - slot.receivedUs;
+
+			frames.fetch_add(1, std::memory_order_relaxed);
+			totalLatencyUs.fetch_add(latency, std::memory_order_relaxed);
+			if (latency > maxLatencyUs.load(std::memory_order_relaxed)) {
+				maxLatencyUs.store(latency, std::memory_order_relaxed);
+			}
+			return &slot.frame;
+		}
+
+		waiting.store(true);
+		if (h != tail.load() || closed.load()) {
+			/* Raced with a push; if it already cleared the flag its post is ours to take */
+			if (!waiting.exchange(false)) {
+				while (sem_wait(&sem) != 0 && errno == EINTR);
+			}
+			continue;
+		}
+
+		while (sem_wait(&sem) != 0 && errno == EINTR);
+	}
+}
+
+/**
+ * @brief Frees the slot of the frame returned by front(). Called from the reader
+ * thread only.
+ *
+ * @return None
+ */
+void RxRing::pop(void)
+{
+	head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void RxRing::open(void)
+{
+	epoch.fetch_add(1, std::memory_order_acq_rel);
+	closed.store(false);
+}
+
+void RxRing::close(void)
+{
+	closed.store(true);
+	wake();
+}
+
+void RxRing::wake(void)
+{
+	if (waiting.load() && waiting.exchange(false)) {
+		sem_post(&sem);
+	}
+}
+
+void RxRing::getStats(RxStats &stats) const
+{
+	stats.frames = frames.load(std::memory_order_relaxed);
+	stats.dropped = dropped.load(std::memory_order_relaxed);
+	stats.totalLatencyUs = totalLatencyUs.load(std::memory_order_relaxed);
+	stats.maxLatencyUs = maxLatencyUs.load(std::memory_order_relaxed);
+}
+
+size_t RxRing::getHighWaterMark(void) const
+{
+	return highWater.load(std::memory_order_relaxed);
+}
+
+CCEC_END_NAMESPACE
+
+
+/** @} */
+/** @} */
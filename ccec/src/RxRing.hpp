@@ -0,0 +1,120 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_RX_RING_HPP_
+#define HDMI_CCEC_RX_RING_HPP_
+
+#include <stdint.h>
+#include <semaphore.h>
+#include <atomic>
+
+#include "ccec/CCEC.hpp"
+#include "ccec/CECFrame.hpp"
+#include "ccec/Driver.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+/*
+ * Single producer, single consumer ring of received frames, from the HAL
+ * callback thread to the Bus reader.
+ *
+ * The callback copies the bytes from the HAL straight into a slot and publishes
+ * it; the reader dispatches the frame from the slot and then frees it. Neither
+ * side takes a lock or waits on the other. The reader sleeps on a semaphore when
+ * the ring is empty, and the callback posts it only when the reader is actually
+ * asleep.
+ *
+ * A full ring means the reader is behind; the new frame is dropped and counted.
+ * Frames already queued cannot be pushed out, as only the reader may free a slot.
+ *
+ * close() may be called from any thread. It wakes the reader, which then gets
+ * NULL from front() until open() is called again. A callback already past its
+ * closed check can still publish one frame after close(); open() starts a new
+ * epoch, and the reader drops any frame stamped with an older one.
+ */
+class RxRing {
+public:
+	enum {
+		/* Power of two, so that the free running indices wrap cleanly */
+		CAPACITY = 64,
+	};
+
+	RxRing(void);
+	~RxRing(void);
+
+	/* HAL callback thread */
+	bool push(const uint8_t *buf, size_t len);
+
+	/* Reader thread */
+	const CECFrame * front(void);
+	void pop(void);
+
+	void open(void);
+	void close(void);
+
+	void getStats(RxStats &stats) const;
+	size_t getHighWaterMark(void) const;
+
+private:
+	void wake(void);
+
+	struct Slot {
+		CECFrame frame;
+		uint64_t receivedUs;
+		uint32_t epoch;
+	};
+
+	Slot slots[CAPACITY];
+	/* Next slot to read; written by the reader only */
+	alignas(64) std::atomic<uint32_t> head;
+	/* Next slot to fill; written by the callback only */
+	alignas(64) std::atomic<uint32_t> tail;
+	std::atomic<bool> waiting;
+	std::atomic<bool> closed;
+	/* Bumped by open() */
+	std::atomic<uint32_t> epoch;
+	sem_t sem;
+
+	std::atomic<uint32_t> frames;
+	std::atomic<uint32_t> dropped;
+	std::atomic<uint32_t> highWater;
+	std::atomic<uint64_t> totalLatencyUs;
+	std::atomic<uint64_t> maxLatencyUs;
+
+	RxRing(const RxRing &); /* Not allowed */
+	RxRing & operator = (const RxRing &); /* Not allowed */
+};
+
+CCEC_END_NAMESPACE
+
+#endif
+
+
+/** @} */
+/** @} */
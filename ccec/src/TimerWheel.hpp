@@ -0,0 +1,148 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_TIMER_WHEEL_HPP_
+#define HDMI_CCEC_TIMER_WHEEL_HPP_
+
+#include <stdint.h>
+#include <vector>
+
+#include "ccec/CCEC.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+/*
+ * Hashed timer wheel, owned by a single thread.
+ *
+ * An item is put in the slot of the tick it is due in. Items due more than one
+ * revolution ahead share a slot with nearer ones and stay there until their own
+ * due time has passed, so any delay can be scheduled. expire() visits only the
+ * slots of the ticks elapsed since the last call, which keeps both schedule()
+ * and expire() independent of how many items are pending.
+ *
+ * Times are in microseconds of a monotonic clock.
+ */
+template <class T>
+class TimerWheel {
+public:
+	enum {
+		SLOTS = 128,
+	};
+
+	TimerWheel(uint64_t tickUs) : tickUs(tickUs), cursor(0), cursorUs(0), count(0) {}
+
+	void schedule(const T &item, uint64_t dueUs, uint64_t nowUs) {
+		if (count == 0) {
+			cursorUs = nowUs;
+		}
+
+		uint64_t ticks = (dueUs > cursorUs) ? (dueUs - cursorUs) / tickUs : 0;
+		Node node = {item, dueUs};
+		slots[(cursor + ticks) % SLOTS].push_back(node);
+		count++;
+	}
+
+	/* Moves the items due by nowUs to expired, in no particular order */
+	void expire(uint64_t nowUs, std::vector<T> &expired) {
+		for (int visited = 0; count > 0 && cursorUs <= nowUs; visited++) {
+			std::vector<Node> &slot = slots[cursor];
+			for (size_t i = 0; i < slot.size();) {
+				if (slot[i].dueUs <= nowUs) {
+					expired.push_back(slot[i].item);
+					slot[i] = slot.back();
+					slot.pop_back();
+					count--;
+				}
+				else {
+					i++;
+				}
+			}
+
+			/* The current tick is not over yet, come back to it on the next call */
+			if (nowUs - cursorUs < tickUs) {
+				break;
+			}
+
+			uint64_t ticks = 1;
+			/*
+			 * After a long stall every slot has been visited once; skip ahead to the
+			 * tick of nowUs. The cursor moves with the time, so that pending items
+			 * stay in the slot of their due tick.
+			 */
+			if (visited == SLOTS - 1) {
+				ticks = (nowUs - cursorUs) / tickUs;
+			}
+			cursor = (int)((cursor + ticks) % SLOTS);
+			cursorUs += ticks * tickUs;
+		}
+	}
+
+	/* Moves all items to expired, due or not */
+	void drain(std::vector<T> &expired) {
+		for (int i = 0; i < SLOTS; i++) {
+			for (size_t j = 0; j < slots[i].size(); j++) {
+				expired.push_back(slots[i][j].item);
+			}
+			slots[i].clear();
+		}
+		count = 0;
+	}
+
+	size_t size(void) const {
+		return count;
+	}
+
+	uint64_t getTick(void) const {
+		return tickUs;
+	}
+
+private:
+	struct Node {
+		T item;
+		uint64_t dueUs;
+	};
+
+	std::vector<Node> slots[SLOTS];
+	uint64_t tickUs;
+	int cursor;
+	/* Start of the tick of the slot under the cursor */
+	uint64_t cursorUs;
+	size_t count;
+
+	TimerWheel(const TimerWheel &); /* Not allowed */
+	TimerWheel & operator = (const TimerWheel &); /* Not allowed */
+};
+
+CCEC_END_NAMESPACE
+
+#endif
+
+
+/** @} */
+/** @} */
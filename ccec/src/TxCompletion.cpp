@@ -0,0 +1,280 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+#include "ccec/TxCompletion.hpp"
+#include "ccec/Util.hpp"
+
+CCEC_BEGIN_NAMESPACE
+
+/*
+ * Shared by all copies of a handle. Allocated once per async frame with
+ * make_shared, so it holds a std::mutex and condition variable in place
+ * rather than an osal ConditionVariable, which allocates three more objects.
+ */
+struct TxCompletion::State {
+	State(TxCompletionListener *listener, TxPriority priority, const TxRetryPolicy &policy)
+	: listener(listener), priority(priority), policy(policy), done(false), result(SEND_INVALID_STATE), attempts(0),
+	  queuedTime(GetMonotonicTimeUs()), startedTime(0), completedTime(0) {}
+
+	TxCompletionListener *listener;
+	TxPriority priority;
+	TxRetryPolicy policy;
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::atomic<bool> done;
+	SendResult result;
+	int attempts;
+	uint64_t queuedTime;
+	uint64_t startedTime;
+	uint64_t completedTime;
+};
+
+/**
+ * @brief Returns the policy that sync sends with a timeout have always used:
+ * retry every 250 ms until the timeout has passed. The timeout is also the
+ * deadline, so the frame does not wait in the queue past it either.
+ *
+ * @param[in] timeout Time period for retrying, in milliseconds.
+ *
+ * @return Retry policy.
+ */
+TxRetryPolicy TxRetryPolicy::forTimeout(int timeout)
+{
+	if (timeout <= 0) {
+		return TxRetryPolicy();
+	}
+	return TxRetryPolicy(timeout / DEFAULT_BACKOFF_MS + 1, DEFAULT_BACKOFF_MS, BACKOFF_FIXED,
+	                     GetMonotonicTimeUs() + (uint64_t)timeout * 1000);
+}
+
+bool TxRetryPolicy::isRetrying(void) const
+{
+	return (maxAttempts > 1);
+}
+
+/**
+ * @brief Decides whether a failed frame is tried again, and when.
+ *
+ * @param[in] attempts Number of attempts made so far.
+ * @param[in] result Result of the last attempt.
+ * @param[in] now Current time, in microseconds of GetMonotonicTimeUs().
+ * @param[out] when Time of the next attempt.
+ *
+ * @return TRUE if the frame is to be retried, otherwise FALSE.
+ */
+bool TxRetryPolicy::getRetryTime(int attempts, SendResult result, uint64_t now, uint64_t &when) const
+{
+	if (result != SEND_NACKED && result != SEND_BUS_ERROR && result != SEND_TIMED_OUT) {
+		return false;
+	}
+	if (attempts >= maxAttempts) {
+		return false;
+	}
+
+	uint64_t delay = backoff;
+	if (type == BACKOFF_EXPONENTIAL) {
+		for (int i = 1; i < attempts && delay < maxBackoff; i++) {
+			delay *= 2;
+		}
+		if (delay > maxBackoff) {
+			delay = maxBackoff;
+		}
+	}
+
+	when = now + delay * 1000;
+	if (deadline != 0 && when > deadline) {
+		/* The last retry is made at the deadline rather than dropped */
+		if (now >= deadline) {
+			return false;
+		}
+		when = deadline;
+	}
+	return true;
+}
+
+TxCompletion::TxCompletion(void)
+{
+}
+
+TxCompletion TxCompletion::create(TxCompletionListener *listener, TxPriority priority, const TxRetryPolicy &policy)
+{
+	TxCompletion completion;
+	completion.state = std::make_shared<State>(listener, priority, policy);
+	return completion;
+}
+
+bool TxCompletion::isValid(void) const
+{
+	return (bool)state;
+}
+
+/**
+ * @brief Checks whether the writer is done with the frame.
+ *
+ * @return TRUE once the result is available, otherwise FALSE.
+ */
+bool TxCompletion::isDone(void) const
+{
+	return state && state->done.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Waits until the writer is done with the frame.
+ *
+ * @return Result of the last attempt.
+ */
+SendResult TxCompletion::wait(void) const
+{
+	if (!state) return SEND_INVALID_STATE;
+
+	std::unique_lock<std::mutex> lock_(state->mutex);
+	while (!state->done.load(std::memory_order_relaxed)) {
+		state->cond.wait(lock_);
+	}
+	return state->result;
+}
+
+/**
+ * @brief Waits at most timeout milliseconds for the writer to be done with the frame.
+ *
+ * @param[in] timeout Time to wait, in milliseconds.
+ * @param[out] result Result of the last attempt, if done.
+ *
+ * @return TRUE if the frame was completed in time, otherwise FALSE.
+ */
+bool TxCompletion::wait(long timeout, SendResult &result) const
+{
+	if (!state) {
+		result = SEND_INVALID_STATE;
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lock_(state->mutex);
+	if (!state->cond.wait_for(lock_, std::chrono::milliseconds(timeout),
+			[this] { return state->done.load(std::memory_order_relaxed); })) {
+		return false;
+	}
+	result = state->result;
+	return true;
+}
+
+SendResult TxCompletion::getResult(void) const
+{
+	return isDone() ? state->result : SEND_INVALID_STATE;
+}
+
+int TxCompletion::getAttempts(void) const
+{
+	return isDone() ? state->attempts : 0;
+}
+
+uint64_t TxCompletion::getQueuedTime(void) const
+{
+	return state ? state->queuedTime : 0;
+}
+
+uint64_t TxCompletion::getStartedTime(void) const
+{
+	return isDone() ? state->startedTime : 0;
+}
+
+uint64_t TxCompletion::getCompletedTime(void) const
+{
+	return isDone() ? state->completedTime : 0;
+}
+
+TxPriority TxCompletion::getPriority(void) const
+{
+	return state ? state->priority : TX_PRIORITY_RESPONSE;
+}
+
+uint64_t TxCompletion::getDeadline(void) const
+{
+	return state ? state->policy.deadline : 0;
+}
+
+/*
+ * Called by the writer each time it takes the frame from the queue for an attempt.
+ */
+void TxCompletion::start(void) const
+{
+	if (!state) return;
+
+	if (state->attempts++ == 0) {
+		state->startedTime = GetMonotonicTimeUs();
+	}
+}
+
+/*
+ * Called by the writer after a failed attempt; see TxRetryPolicy::getRetryTime().
+ */
+bool TxCompletion::getRetryTime(SendResult result, uint64_t now, uint64_t &when) const
+{
+	return state && state->policy.getRetryTime(state->attempts, result, now, when);
+}
+
+/*
+ * Called by the writer once with the final result. Waiters are woken before
+ * the listener runs, so a slow listener does not hold them up.
+ */
+void TxCompletion::complete(SendResult result) const
+{
+	if (!state) return;
+
+	if (result == SEND_NACKED && state->policy.isRetrying()) {
+		result = SEND_TIMED_OUT;
+	}
+
+	{std::lock_guard<std::mutex> lock_(state->mutex);
+		state->result = result;
+		state->completedTime = GetMonotonicTimeUs();
+		state->done.store(true, std::memory_order_release);
+	}
+	state->cond.notify_all();
+
+	if (state->listener != NULL) {
+		try {
+			state->listener->onTxCompleted(*this);
+		}
+		catch (...) {
+			CCEC_LOG( LOG_EXP, "TxCompletionListener threw, ignored\r\n");
+		}
+	}
+}
+
+CCEC_END_NAMESPACE
+
+
+/** @} */
+/** @} */
@@ -0,0 +1,500 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#include <string.h>
+
+#include "TxQueue.hpp"
+#include "ccec/CECFrame.hpp"
+#include "ccec/OpCode.hpp"
+#include "ccec/Operands.hpp"
+#include "ccec/Util.hpp"
+
+using CCEC_OSAL::AutoLock;
+
+CCEC_BEGIN_NAMESPACE
+
+/*
+ * How long a frame may wait before it is sent ahead of higher classes.
+ * A frame takes 25 to 50 ms on the wire, and CEC expects replies within 1 s.
+ */
+static const uint64_t agingLimitUs[TX_PRIORITY_MAX] = {
+	0,              /* TX_PRIORITY_INTERACTIVE: always first */
+	200 * 1000,     /* TX_PRIORITY_RESPONSE */
+	500 * 1000,     /* TX_PRIORITY_ANNOUNCEMENT */
+	1000 * 1000,    /* TX_PRIORITY_BACKGROUND */
+};
+
+/*
+ * Messages for which a newer frame makes a queued one obsolete. Two frames match
+ * when they have the same header (initiator and destination), opcode and, where
+ * keyLength is set, leading operand bytes. A match is only replaced if no frame
+ * with the barrier opcode (the opcode itself when there is none) was queued
+ * after it, so eg a key press is not merged across the release that ended it.
+ */
+struct CoalesceRule {
+	Op_t opCode;
+	size_t keyLength;
+	Op_t barrier;
+};
+
+static const CoalesceRule coalesceRules[] = {
+	{REPORT_AUDIO_STATUS,   0, REPORT_AUDIO_STATUS},
+	{ACTIVE_SOURCE,         0, INACTIVE_SOURCE},
+	{REPORT_POWER_STATUS,   0, REPORT_POWER_STATUS},
+	{SET_SYSTEM_AUDIO_MODE, 0, SET_SYSTEM_AUDIO_MODE},
+	{USER_CONTROL_PRESSED,  1, USER_CONTROL_RELEASED},
+};
+
+static const CoalesceRule * findCoalesceRule(const CECFrame &frame)
+{
+	if (frame.length() < 2) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < sizeof(coalesceRules) / sizeof(coalesceRules[0]); i++) {
+		if (coalesceRules[i].opCode == frame.at(1)) {
+			return (frame.length() >= 2 + coalesceRules[i].keyLength) ? &coalesceRules[i] : NULL;
+		}
+	}
+	return NULL;
+}
+
+/* Destination of a frame; the stop sentinel goes with the broadcasts, which are never backed off */
+static int destinationOf(const CECFrame *frame)
+{
+	return (frame != NULL && frame->length() > 0) ? (frame->at(0) & 0x0F) : LogicalAddress::BROADCAST;
+}
+
+TxQueue::TxQueue(void) : count(0), seq(0)
+{
+	memset(nextDestination, 0, sizeof(nextDestination));
+	memset(destinations, 0, sizeof(destinations));
+	memset(held, 0, sizeof(held));
+	memset(stats, 0, sizeof(stats));
+}
+
+TxQueue::~TxQueue(void)
+{AutoLock lock_(mutex);
+	if (count != 0) {
+		CCEC_LOG( LOG_WARN, "TxQueue destroyed with %zu frames queued\r\n", count);
+	}
+}
+
+/**
+ * @brief Queues a frame for the writer.
+ *
+ * @param[in] frame Frame to be sent, or NULL to stop the writer.
+ * @param[in] priority Priority class of the frame.
+ * @param[in] completion Handle to complete once the frame is sent.
+ * @param[in] coalesce TRUE if the frame may replace an obsolete queued frame,
+ * which is then handed to the writer through takeSuperseded().
+ *
+ * @return TRUE if the frame replaced a queued frame, otherwise FALSE.
+ */
+bool TxQueue::offer(CECFrame *frame, TxPriority priority, const TxCompletion &completion, bool coalesce)
+{
+	if (frame == NULL || priority < TX_PRIORITY_INTERACTIVE || priority >= TX_PRIORITY_MAX) {
+		priority = TX_PRIORITY_INTERACTIVE;
+	}
+
+	{AutoLock lock_(mutex);
+		if (coalesce && frame != NULL && this->coalesce(frame, priority, completion)) {
+			stats[priority].superseded++;
+			/* Wake the writer to complete the replaced frame */
+			cond.set();
+			cond.notify();
+			return true;
+		}
+
+		Entry entry = {frame, GetMonotonicTimeUs(), completion, seq++, false};
+		queues[priority][destinationOf(frame)].push_back(entry);
+		count++;
+		cond.set();
+		cond.notify();
+	}
+
+	return false;
+}
+
+/*
+ * Puts frame in the place of the newest queued frame of its class it makes
+ * obsolete, if any. The new frame keeps the position and queue time of the
+ * replaced one, which is added to superseded.
+ */
+bool TxQueue::coalesce(CECFrame *frame, TxPriority priority, const TxCompletion &completion)
+{
+	const CoalesceRule *rule = findCoalesceRule(*frame);
+	if (rule == NULL) {
+		return false;
+	}
+
+	std::deque<Entry> &queue = queues[priority][destinationOf(frame)];
+	for (std::deque<Entry>::reverse_iterator it = queue.rbegin(); it != queue.rend(); ++it) {
+		const CECFrame *queued = it->frame;
+		if (queued == NULL || queued->length() < 2) {
+			continue;
+		}
+		if (queued->at(1) == rule->barrier && queued->at(1) != rule->opCode) {
+			return false;
+		}
+		if (queued->at(1) != rule->opCode || queued->at(0) != frame->at(0)) {
+			continue;
+		}
+
+		/* Same message to the same device: replace it if the key matches, otherwise stop */
+		if (queued->length() < 2 + rule->keyLength ||
+			memcmp(queued->getBuffer() + 2, frame->getBuffer() + 2, rule->keyLength) != 0) {
+			return false;
+		}
+		/* Barriers to other destinations, eg <Inactive Source> to the TV after a broadcast <Active Source> */
+		if (rule->barrier != rule->opCode && hasBarrier(priority, rule->barrier, it->seq)) {
+			return false;
+		}
+
+		Superseded replaced = {it->frame, it->completion};
+		superseded.push_back(replaced);
+		it->frame = frame;
+		it->completion = completion;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ * Whether a frame with the barrier opcode was queued in the class after the
+ * frame with sequence number after.
+ */
+bool TxQueue::hasBarrier(TxPriority priority, Op_t barrier, uint64_t after) const
+{
+	for (int destination = 0; destination < DESTINATIONS; destination++) {
+		const std::deque<Entry> &queue = queues[priority][destination];
+		for (std::deque<Entry>::const_reverse_iterator it = queue.rbegin(); it != queue.rend() && it->seq > after; ++it) {
+			if (it->frame != NULL && it->frame->length() >= 2 && it->frame->at(1) == barrier) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Holds the later frames of a class to the destination of a frame that
+ * failed, until the frame is put back with requeue() for its next attempt.
+ *
+ * @param[in] frame Frame waiting for its next attempt.
+ * @param[in] priority Priority class the frame was queued in.
+ */
+void TxQueue::hold(const CECFrame &frame, TxPriority priority)
+{
+	if (priority < TX_PRIORITY_INTERACTIVE || priority >= TX_PRIORITY_MAX) {
+		priority = TX_PRIORITY_INTERACTIVE;
+	}
+
+	{AutoLock lock_(mutex);
+		held[priority][destinationOf(&frame)]++;
+	}
+}
+
+/**
+ * @brief Puts a frame held with hold() back at the front of its queue, ahead
+ * of the frames that were queued after it, and releases the hold.
+ *
+ * @param[in] frame Frame due for its next attempt.
+ * @param[in] priority Priority class the frame was queued in.
+ * @param[in] completion Handle queued with the frame.
+ */
+void TxQueue::requeue(CECFrame *frame, TxPriority priority, const TxCompletion &completion)
+{
+	if (priority < TX_PRIORITY_INTERACTIVE || priority >= TX_PRIORITY_MAX) {
+		priority = TX_PRIORITY_INTERACTIVE;
+	}
+
+	{AutoLock lock_(mutex);
+		int destination = destinationOf(frame);
+		if (held[priority][destination] > 0) {
+			held[priority][destination]--;
+		}
+
+		Entry entry = {frame, GetMonotonicTimeUs(), completion, seq++, true};
+		queues[priority][destination].push_front(entry);
+		count++;
+		cond.set();
+		cond.notify();
+	}
+}
+
+/**
+ * @brief Takes the next frame to be sent, waiting at most timeout milliseconds
+ * for one if the queue is empty or only holds frames to backed off destinations.
+ *
+ * @param[out] frame Frame to be sent, or NULL if the writer is to stop.
+ * @param[out] completion Handle queued with the frame.
+ * @param[in] timeout Time to wait in milliseconds, 0 to wait until a frame is queued.
+ *
+ * @return TRUE if a frame was taken, FALSE if the wait timed out or there are
+ * superseded frames for takeSuperseded().
+ */
+bool TxQueue::poll(CECFrame *&frame, TxCompletion &completion, long timeout)
+{
+	uint64_t deadline = GetMonotonicTimeUs() + (uint64_t)timeout * 1000;
+
+	for (;;) {
+		uint64_t now = GetMonotonicTimeUs();
+		long wait = 0;
+
+		{AutoLock lock_(mutex);
+			int priority, destination;
+			uint64_t readyUs = 0;
+
+			if (!superseded.empty()) {
+				return false;
+			}
+
+			if (pick(now, priority, destination, readyUs)) {
+				std::deque<Entry> &queue = queues[priority][destination];
+				frame = queue.front().frame;
+				uint64_t enqueuedUs = queue.front().enqueuedUs;
+				bool retry = queue.front().retry;
+				completion = std::move(queue.front().completion);
+				queue.pop_front();
+				if (--count == 0) {
+					cond.reset();
+				}
+
+				/* A retry was counted when it was first taken; its requeue time is not when it was offered */
+				if (frame != NULL && !retry) {
+					uint64_t waited = now - enqueuedUs;
+					stats[priority].frames++;
+					stats[priority].totalWaitUs += waited;
+					if (waited > stats[priority].maxWaitUs) {
+						stats[priority].maxWaitUs = waited;
+					}
+				}
+
+				return true;
+			}
+
+			/* Empty, or every queued frame is backed off until readyUs; a new offer wakes us up early */
+			cond.reset();
+			if (readyUs != 0) {
+				wait = (long)((readyUs - now + 999) / 1000);
+			}
+		}
+
+		if (timeout != 0) {
+			if (now >= deadline) {
+				return false;
+			}
+			long left = (long)((deadline - now + 999) / 1000);
+			if (wait == 0 || left < wait) {
+				wait = left;
+			}
+		}
+
+		cond.wait(wait);
+	}
+}
+
+/**
+ * @brief Takes the frames replaced by newer ones since the last call. The
+ * writer completes them with SEND_SUPERSEDED.
+ *
+ * @param[out] frames Replaced frames, appended in the order they were replaced.
+ */
+void TxQueue::takeSuperseded(std::vector<Superseded> &frames)
+{AutoLock lock_(mutex);
+	frames.insert(frames.end(), superseded.begin(), superseded.end());
+	superseded.clear();
+}
+
+/*
+ * Whether the frame at the front of a destination queue may be sent now. A
+ * backed off destination is still served while any of its queued frames is on
+ * a retry, which its own policy already paces, or has a deadline before the
+ * back off ends. Frames are taken from the front either way, in order.
+ */
+bool TxQueue::isReady(int priority, int destination, uint64_t now) const
+{
+	if (held[priority][destination] > 0) {
+		return false;
+	}
+
+	uint64_t backoffUntilUs = destinations[destination].backoffUntilUs;
+	if (backoffUntilUs <= now) {
+		return true;
+	}
+
+	const std::deque<Entry> &queue = queues[priority][destination];
+	for (std::deque<Entry>::const_iterator it = queue.begin(); it != queue.end(); ++it) {
+		uint64_t deadline = it->completion.getDeadline();
+		if (it->retry || (deadline != 0 && deadline < backoffUntilUs)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Picks the queue to take the next frame from. The class is the one with the
+ * oldest ready frame past its aging limit, otherwise the highest class with a
+ * ready frame; within the class the destinations take turns. If nothing is
+ * ready, readyUs is set to when the first backed off destination is, or 0 if
+ * the queue is empty.
+ */
+bool TxQueue::pick(uint64_t now, int &priority, int &destination, uint64_t &readyUs)
+{
+	int highest = -1;
+	int overdue = -1;
+	uint64_t oldest = 0;
+
+	readyUs = 0;
+
+	for (int p = 0; p < TX_PRIORITY_MAX; p++) {
+		for (int d = 0; d < DESTINATIONS; d++) {
+			if (queues[p][d].empty()) {
+				continue;
+			}
+
+			const Entry &front = queues[p][d].front();
+			if (!isReady(p, d, now)) {
+				/* A held queue is ready again once the writer requeues its frame, which wakes us up */
+				if (held[p][d] > 0) {
+					continue;
+				}
+				if (readyUs == 0 || destinations[d].backoffUntilUs < readyUs) {
+					readyUs = destinations[d].backoffUntilUs;
+				}
+				continue;
+			}
+
+			if (highest < 0) {
+				highest = p;
+			}
+
+			uint64_t wait = now - front.enqueuedUs;
+			if (p > highest && wait > agingLimitUs[p] && (overdue < 0 || wait > oldest)) {
+				overdue = p;
+				oldest = wait;
+			}
+		}
+	}
+
+	if (highest < 0) {
+		return false;
+	}
+
+	priority = (overdue >= 0) ? overdue : highest;
+
+	for (int i = 0; i < DESTINATIONS; i++) {
+		int d = (nextDestination[priority] + i) % DESTINATIONS;
+		if (!queues[priority][d].empty() && isReady(priority, d, now)) {
+			destination = d;
+			nextDestination[priority] = (d + 1) % DESTINATIONS;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Records the outcome of a frame the writer sent, to back off
+ * destinations that keep NACKing. Broadcasts are never NACKed.
+ *
+ * @param[in] frame Frame sent.
+ * @param[in] result Result of the attempt.
+ */
+void TxQueue::reportResult(const CECFrame &frame, SendResult result)
+{
+	int destination = destinationOf(&frame);
+	if (destination == LogicalAddress::BROADCAST) {
+		return;
+	}
+
+	{AutoLock lock_(mutex);
+		Destination &state = destinations[destination];
+
+		if (result == SEND_ACKED) {
+			if (state.nacks >= BACKOFF_NACKS) {
+				CCEC_LOG( LOG_INFO, "TxQueue destination %d is back after %d NACKs\r\n", destination, state.nacks);
+			}
+			state.nacks = 0;
+			state.backoffUntilUs = 0;
+			return;
+		}
+		if (result != SEND_NACKED || ++state.nacks < BACKOFF_NACKS) {
+			return;
+		}
+
+		/* Double the back off with every further NACK */
+		uint64_t backoff = BACKOFF_MIN_MS;
+		for (int i = BACKOFF_NACKS; i < state.nacks && backoff < BACKOFF_MAX_MS; i++) {
+			backoff *= 2;
+		}
+		if (backoff > BACKOFF_MAX_MS) {
+			backoff = BACKOFF_MAX_MS;
+		}
+		state.backoffUntilUs = GetMonotonicTimeUs() + backoff * 1000;
+
+		if (state.nacks == BACKOFF_NACKS) {
+			CCEC_LOG( LOG_INFO, "TxQueue destination %d NACKed %d times, backing off\r\n", destination, state.nacks);
+		}
+	}
+}
+
+size_t TxQueue::size(void)
+{AutoLock lock_(mutex);
+	return count;
+}
+
+/**
+ * @brief Returns how long the frames of a priority class waited to be sent.
+ *
+ * @param[in] priority Priority class.
+ * @param[out] stats Number of frames sent, their total and longest wait, and how
+ * many queued frames were superseded.
+ */
+void TxQueue::getStats(TxPriority priority, TxQueueStats &stats)
+{
+	memset(&stats, 0, sizeof(stats));
+	if (priority < TX_PRIORITY_INTERACTIVE || priority >= TX_PRIORITY_MAX) {
+		return;
+	}
+
+	{AutoLock lock_(mutex);
+		stats = this->stats[priority];
+	}
+}
+
+CCEC_END_NAMESPACE
+
+
+/** @} */
+/** @} */
@@ -0,0 +1,159 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup ccec
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_TX_QUEUE_HPP_
+#define HDMI_CCEC_TX_QUEUE_HPP_
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+#include "osal/Mutex.hpp"
+#include "osal/ConditionVariable.hpp"
+
+#include "ccec/CCEC.hpp"
+#include "ccec/Driver.hpp"
+#include "ccec/OpCode.hpp"
+#include "ccec/TxCompletion.hpp"
+
+using CCEC_OSAL::Mutex;
+using CCEC_OSAL::ConditionVariable;
+
+CCEC_BEGIN_NAMESPACE
+
+class CECFrame;
+
+/*
+ * Transmit queue of the Bus writer.
+ *
+ * Frames are queued per priority class and taken from the highest class that
+ * has any. A frame that has waited longer than the aging limit of its class is
+ * taken ahead of the higher classes, oldest first, so a steady stream of
+ * interactive traffic cannot starve the rest.
+ *
+ * Within a class every destination logical address has its own queue, and the
+ * writer goes round the destinations with frames. A destination that keeps
+ * NACKing (a device that is off or gone) is backed off: its frames stay queued
+ * while the other destinations are served, so one dead device does not hold up
+ * the TV or the AVR. Frames that are being retried by their own policy are
+ * already paced and are not held back, and neither are frames whose deadline
+ * comes before the back off ends.
+ *
+ * While a frame waits for its next attempt, the later frames of its class to
+ * the same destination are held, and the frame goes back to the front of its
+ * queue when the attempt is due. A retry never lets the frames queued behind it
+ * reach the device first, eg a <User Control Released> before its press.
+ *
+ * Each frame travels with the completion handle returned to the sender.
+ *
+ * When coalescing is asked for, a frame that makes a queued, not yet sent frame
+ * obsolete (a newer <Report Audio Status>, <Active Source>, <Report Power
+ * Status>, <Set System Audio Mode>, or a repeat of the same key press) takes
+ * that frame's place in the queue instead of queuing behind it. The replaced
+ * frame is handed to the writer, which completes it like any other frame.
+ *
+ * A NULL frame is the writer's stop sentinel; it is queued in the highest class.
+ */
+class TxQueue {
+public:
+	enum {
+		DESTINATIONS = 16,
+		/* Consecutive NACKs after which a destination is backed off */
+		BACKOFF_NACKS = 2,
+		BACKOFF_MIN_MS = 100,
+		BACKOFF_MAX_MS = 1000,
+	};
+
+	TxQueue(void);
+	~TxQueue(void);
+
+	/* A queued frame replaced by a newer one; the writer completes its handle and releases it */
+	struct Superseded {
+		CECFrame *frame;
+		TxCompletion completion;
+	};
+
+	bool offer(CECFrame *frame, TxPriority priority, const TxCompletion &completion = TxCompletion(),
+	           bool coalesce = false);
+	void hold(const CECFrame &frame, TxPriority priority);
+	void requeue(CECFrame *frame, TxPriority priority, const TxCompletion &completion);
+	bool poll(CECFrame *&frame, TxCompletion &completion, long timeout);
+	void takeSuperseded(std::vector<Superseded> &frames);
+	size_t size(void);
+
+	void reportResult(const CECFrame &frame, SendResult result);
+
+	void getStats(TxPriority priority, TxQueueStats &stats);
+
+private:
+	struct Entry {
+		CECFrame *frame;
+		uint64_t enqueuedUs;
+		TxCompletion completion;
+		/* Order of the offer, across all queues */
+		uint64_t seq;
+		/* Put back by requeue() for another attempt */
+		bool retry;
+	};
+
+	struct Destination {
+		int nacks;
+		uint64_t backoffUntilUs;
+	};
+
+	bool isReady(int priority, int destination, uint64_t now) const;
+	bool pick(uint64_t now, int &priority, int &destination, uint64_t &readyUs);
+	bool coalesce(CECFrame *frame, TxPriority priority, const TxCompletion &completion);
+	bool hasBarrier(TxPriority priority, Op_t barrier, uint64_t after) const;
+
+	std::deque<Entry> queues[TX_PRIORITY_MAX][DESTINATIONS];
+	/* Destination each class serves next */
+	int nextDestination[TX_PRIORITY_MAX];
+	Destination destinations[DESTINATIONS];
+	/* Frames of each queue waiting for their next attempt outside of it */
+	int held[TX_PRIORITY_MAX][DESTINATIONS];
+	/* Replaced frames the writer has yet to complete */
+	std::vector<Superseded> superseded;
+	size_t count;
+	uint64_t seq;
+	TxQueueStats stats[TX_PRIORITY_MAX];
+	Mutex mutex;
+	ConditionVariable cond;
+
+	TxQueue(const TxQueue &); /* Not allowed */
+	TxQueue & operator = (const TxQueue &); /* Not allowed */
+};
+
+CCEC_END_NAMESPACE
+
+#endif
+
+
+/** @} */
+/** @} */
@@ -144,5 +144,18 @@ void dump_buffer(unsigned char * buf, int len)
 }
 
 
+/**
+ * @brief Returns the time from a monotonic clock, for measuring intervals.
+ *
+ * @return Time in microseconds.
+ */
+uint64_t GetMonotonicTimeUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+
 /** @} */
 /** @} */
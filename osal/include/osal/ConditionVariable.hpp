@@ -38,6 +38,8 @@
 #ifndef HDMI_CCEC_OSAL_CONDITION_VARIABLE_HPP_
 #define HDMI_CCEC_OSAL_CONDITION_VARIABLE_HPP_
 
+#include <pthread.h>
+
 #include "OSAL.hpp"
 #include "Mutex.hpp"
 #include "Condition.hpp"
@@ -134,9 +136,9 @@ ConditionVariable by calling notify/notifyAll.
 	void notifyAll(void);
 	void *getNativeHandle(void);
 private:
-	Condition *cond;
-	Mutex *mutex;
-	void *nativeHandle;
+	Condition cond;
+	Mutex mutex;
+	pthread_cond_t nativeHandle;
 
 	ConditionVariable(const ConditionVariable &); /* Not allowed */
 	ConditionVariable & operator = (const ConditionVariable &); /* Not allowed */
@@ -39,6 +39,7 @@
 #define HDMI_CCEC_OSAL_EVENTQUEUE_HPP_
 
 #include <stdlib.h>
+#include <time.h>
 #include <deque>
 
 #include "OSAL.hpp"
@@ -54,6 +55,14 @@ This is a collection class which provides the event queue functionality.
 consumer threads could wait on the queue and will be signalled when 
 queue is populated.
 
+Any number of threads may offer and poll. Each offer wakes at most one waiting
+consumer, so a pool of consumers on one queue does not stampede.
+
+The queue is bounded. What offer() does when the queue is full is set by the
+overflow policy; offer() reports the outcome, and any element that did not make
+it into the queue (or was pushed out of it) is handed back to the caller, who
+remains responsible for it.
+
 \param E - type of elements held in this collection.
 */
 /**************************************************************************/
@@ -61,6 +70,20 @@ queue is populated.
 template <class E>
 class EventQueue  {
 public:
+	typedef enum {
+		OVERFLOW_BLOCK = 0,	/* Wait for space, up to the block timeout */
+		OVERFLOW_DROP_OLDEST,	/* Push out the element at the front of the queue */
+		OVERFLOW_DROP_NEWEST,	/* Discard the element being offered */
+		OVERFLOW_REJECT,	/* Refuse the element being offered */
+	} OverflowPolicy;
+
+	typedef enum {
+		OFFER_OK = 0,		/* Element queued */
+		OFFER_DROPPED_OLDEST,	/* Element queued, the oldest one was pushed out */
+		OFFER_DROPPED,		/* Element not queued, counted as dropped */
+		OFFER_REJECTED,		/* Element not queued, queue full */
+		OFFER_TIMED_OUT,	/* Element not queued, no space within the block timeout */
+	} OfferStatus;
 
 /***************************************************************************/
 /*!
@@ -68,12 +91,15 @@ public:
 Creates an EventQueue with the provided capacity.
 
 \param cap - Number of elements that could be held in the queue.
+\param policy - What offer() does when the queue is full.
+\param blockTimeout - Milliseconds OVERFLOW_BLOCK waits for space, 0 for no limit.
 */
 /**************************************************************************/
 
-	EventQueue(size_t cap = 32) {
-		this->cap = cap;
+	EventQueue(size_t cap = 32, OverflowPolicy policy = OVERFLOW_DROP_NEWEST, long blockTimeout = 0)
+	: cap(cap), policy(policy), blockTimeout(blockTimeout), highWater(0), dropped(0), rejected(0) {
 		events = new std::deque<E>(0);
+		space.set();
 	}
 /***************************************************************************/
 /*!
@@ -98,42 +124,125 @@ Consumer will be returned with the object from front of the queue if queue is
 not empty. If queue is empty, consumer threads will wait until an event is 
 posted to the queue.
 
-If waiting thread is awakened by there is no element on queue, a default
-value is returned. This allows the waiting thread to close out the queue.
+A consumer that wakes up to find the queue emptied by another consumer goes
+back to waiting; poll() only returns with an element. A consumer that has to
+be stopped is sent a sentinel element.
 
 \return event from the front of the queue.
 */
 /**************************************************************************/
 
 	E poll(void) {
-		typedef E ET;
 		E front;
-		do {
-			cond.wait();
+
+		for (;;) {
 			{AutoLock lock_(mutex);
-				if (!cond.isSet() || events->empty()) {
-					return ET();
+				if (take(front)) {
+					return front;
 				}
+			}
 
-				if (cond.isSet()) {
-					if (!events->empty()) {
-						front = events->front();
-						events->pop_front();
-						if (events->empty()) {
-							cond.reset();
-						}
-					}
-					else {
-						cond.reset();
-					}
-				} else {
+			/* Returns once the queue has been non-empty since take() found it empty */
+			cond.wait();
+		}
+	}
 
+/***************************************************************************/
+/*!
+\brief method for polling events, waiting at most the given time.
+
+Unlike poll(), an empty queue is never reported as an element: the return value
+says whether one was taken.
+
+\param element - Receives the event from the front of the queue.
+\param timeout - Milliseconds to wait for an event, 0 for no limit.
+\return true if an event was taken, false if none came within the timeout.
+*/
+/**************************************************************************/
+
+	bool poll(E &element, long timeout) {
+		struct timespec deadline;
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_sec += timeout / 1000;
+		deadline.tv_nsec += (timeout % 1000) * 1000000;
+		if (deadline.tv_nsec >= 1000000000) {
+			deadline.tv_nsec -= 1000000000;
+			deadline.tv_sec++;
+		}
+
+		for (;;) {
+			{AutoLock lock_(mutex);
+				if (take(element)) {
+					return true;
 				}
 			}
 
-		} while (0 && front == NULL);
+			long left = timeout;
+			if (timeout != 0) {
+				struct timespec now;
+				clock_gettime(CLOCK_MONOTONIC, &now);
+				left = (deadline.tv_sec - now.tv_sec) * 1000 + (deadline.tv_nsec - now.tv_nsec) / 1000000;
+				if (left <= 0) {
+					return false;
+				}
+			}
+
+			/* Another consumer may get there first; then wait out the rest of the timeout */
+			if (cond.wait(left) == 0) {
+				AutoLock lock_(mutex);
+				return take(element);
+			}
+		}
+	}
+
+/***************************************************************************/
+/*!
+\brief takes the event from the front of the queue, if there is one. Does not
+block.
+
+\param element - Receives the event from the front of the queue.
+\return true if an event was taken, false if the queue was empty.
+*/
+/**************************************************************************/
+
+	bool tryPoll(E &element) {
+		AutoLock lock_(mutex);
+		return take(element);
+	}
+
+/***************************************************************************/
+/*!
+\brief moves up to max events from the front of the queue to the back of a
+container, under one lock. Does not block.
+
+A consumer woken by poll() can take the rest of a burst with one call instead
+of a lock and condition round trip per event.
+
+\param container - Receives the events, in queue order, through push_back().
+\param max - Largest number of events to move.
+\return number of events moved.
+*/
+/**************************************************************************/
+
+	template <class C>
+	size_t drainTo(C &container, size_t max) {
+		AutoLock lock_(mutex);
+		size_t moved = 0;
+
+		while (moved < max && !events->empty()) {
+			container.push_back(events->front());
+			events->pop_front();
+			moved++;
+		}
+
+		if (events->empty()) {
+			cond.reset();
+		}
+		if (moved > 0 && policy == OVERFLOW_BLOCK) {
+			space.notifyAll();
+		}
 
-		return front;
+		return moved;
 	}
 	
 /***************************************************************************/
@@ -159,29 +268,130 @@ Post a event to the queue and signals threads waiting on the queue.
 On receiving the signal (event), if there is any consumer thread waiting
 on the queue will come out of wait state and will consume the event.
 
-\exception - if queue is full, method will throw an exception.
-\param E - Object that is to be posted to the queue.
+If the queue is full the overflow policy applies. Unless OFFER_OK or
+OFFER_DROPPED_OLDEST is returned, the element was not queued and the caller
+still owns it.
+
+\param element - Object that is to be posted to the queue.
+\param evicted - Receives the element pushed out by OVERFLOW_DROP_OLDEST, which
+the caller then owns. May be NULL if the elements need no cleanup.
+\return outcome of the offer.
 */
 /**************************************************************************/
 
-	void offer(E element) {
-    	AutoLock lock_(mutex);
+	OfferStatus offer(E element, E *evicted = NULL) {
+		for (;;) {
+			{AutoLock lock_(mutex);
+				OfferStatus status = OFFER_OK;
 
-    	if (events->size() == cap) {
-			/* @TODO Throw Exception */
-		}
-		else {
-			events->push_back(element);
-			cond.set();
-			cond.notifyAll();
+				if (events->size() >= cap) {
+					switch (policy) {
+					case OVERFLOW_DROP_OLDEST:
+						if (evicted != NULL) {
+							*evicted = events->front();
+						}
+						events->pop_front();
+						dropped++;
+						status = OFFER_DROPPED_OLDEST;
+						break;
+					case OVERFLOW_DROP_NEWEST:
+						dropped++;
+						return OFFER_DROPPED;
+					case OVERFLOW_REJECT:
+						rejected++;
+						return OFFER_REJECTED;
+					case OVERFLOW_BLOCK:
+					default:
+						space.reset();
+						break;
+					}
+				}
+
+				if (events->size() < cap) {
+					events->push_back(element);
+					if (events->size() > highWater) {
+						highWater = events->size();
+					}
+					/* One element, one consumer to wake */
+					cond.notify();
+					return status;
+				}
+			}
+
+			/* OVERFLOW_BLOCK: wait for poll() to make space */
+			if (space.wait(blockTimeout) == 0) {
+				AutoLock lock_(mutex);
+				rejected++;
+				return OFFER_TIMED_OUT;
+			}
 		}
 	}
 
+/***************************************************************************/
+/*!
+\brief returns the largest number of events the queue has held.
+*/
+/**************************************************************************/
+
+	size_t getHighWaterMark(void) {
+		AutoLock lock_(mutex);
+		return highWater;
+	}
+
+/***************************************************************************/
+/*!
+\brief returns the number of events discarded by OVERFLOW_DROP_OLDEST and
+OVERFLOW_DROP_NEWEST.
+*/
+/**************************************************************************/
+
+	size_t getDroppedCount(void) {
+		AutoLock lock_(mutex);
+		return dropped;
+	}
+
+/***************************************************************************/
+/*!
+\brief returns the number of events refused by OVERFLOW_REJECT, or not queued
+within the block timeout of OVERFLOW_BLOCK.
+*/
+/**************************************************************************/
+
+	size_t getRejectedCount(void) {
+		AutoLock lock_(mutex);
+		return rejected;
+	}
+
 private:
+	/* Called with mutex held */
+	bool take(E &element) {
+		if (events->empty()) {
+			cond.reset();
+			return false;
+		}
+
+		element = events->front();
+		events->pop_front();
+		if (events->empty()) {
+			cond.reset();
+		}
+		if (policy == OVERFLOW_BLOCK) {
+			space.notify();
+		}
+		return true;
+	}
+
 	std::deque<E> *events;
 	size_t cap;
+	OverflowPolicy policy;
+	long blockTimeout;
+	size_t highWater;
+	size_t dropped;
+	size_t rejected;
 	Mutex mutex;
 	ConditionVariable cond;
+	/* Set while the queue has space; only used by OVERFLOW_BLOCK */
+	ConditionVariable space;
 };
 
 CCEC_OSAL_END_NAMESPACE
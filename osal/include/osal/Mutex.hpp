@@ -37,6 +37,8 @@
 #ifndef HDMI_CCEC_OSAL_MUTEX_HPP_
 #define HDMI_CCEC_OSAL_MUTEX_HPP_
 
+#include <pthread.h>
+
 #include "OSAL.hpp"
 
 CCEC_OSAL_BEGIN_NAMESPACE
@@ -46,23 +48,53 @@ CCEC_OSAL_BEGIN_NAMESPACE
 
 This class provides synchronization primitive for implementing critical sections
 and protect shared data from concurrent access. This class provides functionaliy
-of a recurisive (same thread can take the lock multiple times) mutual exclusive lock.
+of a mutual exclusive lock.
+
+The mutex is not recursive unless asked for: a thread that locks it again
+before unlocking it deadlocks. Code that does re-enter a lock it holds, eg
+from a listener called with the lock held, uses RecursiveMutex.
+
+The native mutex is held in the object itself, so creating a Mutex does not
+allocate, and lock() and unlock() are inline.
 */
 /**************************************************************************/
 
 class Mutex {
 public:
+	typedef enum {
+		TYPE_NORMAL = 0,	/* Not recursive */
+		TYPE_ADAPTIVE,		/* Not recursive, spins briefly before it sleeps where the platform supports it */
+		TYPE_RECURSIVE,		/* The owner may lock it again, see RecursiveMutex */
+	} Type;
+
 /***************************************************************************/
 /*!
 \brief Constructor.
 Creates Mutex object. 
 
+\param type - Kind of native mutex.
+*/
+/**************************************************************************/
+
+	Mutex(Type type = TYPE_NORMAL);
+
+/***************************************************************************/
+/*!
+\brief Copy constructor.
+Creates a new, unlocked Mutex of the same type. The lock state is not copied.
+*/
+/**************************************************************************/
+
+	Mutex(const Mutex &rhs);
+
+/***************************************************************************/
+/*!
+\brief Assignment.
+Does nothing; each object keeps its own native mutex.
 */
 /**************************************************************************/
 
-	Mutex(void);
-	Mutex(const Mutex &);
-	Mutex & operator = (const Mutex &);
+	Mutex & operator = (const Mutex &rhs);
 
 /***************************************************************************/
 /*!
@@ -82,14 +114,15 @@ Calling thread will acquire the mutex lock if available and will immediately
 return. Subsequent call by other threads before current thread releasing the
 mutex will result in those threads to block. 
 
-\note Current thread can call lock() for same object multiple times before 
-releasing the mutex. But for releasing the lock to other threads, same number
-of unlock calls shall be made by the locking thread.
+\note Only a RecursiveMutex may be locked again by the thread that holds it,
+and then the same number of unlock calls shall be made by the locking thread.
 
 */
 /**************************************************************************/
 
-	void lock(void);
+	void lock(void) {
+		pthread_mutex_lock(&nativeHandle);
+	}
 /***************************************************************************/
 /*!
 \brief Unlocks the given mutex 
@@ -102,7 +135,9 @@ will be able to acquire the lock released and will come out of wait state.
 /**************************************************************************/
 
 
-	void unlock(void);
+	void unlock(void) {
+		pthread_mutex_unlock(&nativeHandle);
+	}
 
 /***************************************************************************/
 /*!
@@ -115,7 +150,23 @@ will be able to acquire the lock released and will come out of wait state.
 
 	void *getNativeHandle(void);
 private:
-	void *nativeHandle;
+	void init(void);
+
+	Type type;
+	pthread_mutex_t nativeHandle;
+};
+
+/***************************************************************************/
+/*!
+
+Mutex that the thread holding it may lock again, for the few places that
+re-enter a lock.
+*/
+/**************************************************************************/
+
+class RecursiveMutex : public Mutex {
+public:
+	RecursiveMutex(void) : Mutex(TYPE_RECURSIVE) {}
 };
 
 class AutoLock
@@ -0,0 +1,311 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*****************************************************************************/
+/*!
+\file
+\brief This file defines interface of RingQueue class.
+
+*/
+/*****************************************************************************/
+
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup osal
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_OSAL_RINGQUEUE_HPP_
+#define HDMI_CCEC_OSAL_RINGQUEUE_HPP_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <atomic>
+
+#include "OSAL.hpp"
+
+CCEC_OSAL_BEGIN_NAMESPACE
+
+/***************************************************************************/
+/*!
+
+Producer policies of RingQueue.
+
+SingleProducer is for queues that only one thread offers to; a slot is taken
+with a plain store. MultiProducer lets any number of threads offer; a slot is
+taken with a compare and swap.
+*/
+/**************************************************************************/
+
+class SingleProducer {
+public:
+	static bool claim(std::atomic<size_t> &tail, size_t &pos) {
+		tail.store(pos + 1, std::memory_order_relaxed);
+		return true;
+	}
+};
+
+class MultiProducer {
+public:
+	static bool claim(std::atomic<size_t> &tail, size_t &pos) {
+		return tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed);
+	}
+};
+
+/***************************************************************************/
+/*!
+
+Fixed capacity, lock-free queue with one consumer thread, for the hot paths
+where EventQueue's mutex and condition variable cost too much.
+
+Elements are held in a ring that is allocated once, when the queue is built.
+Each slot carries a sequence number that tells producer and consumer whose turn
+it is, so neither side takes a lock. The producer and consumer indices sit on
+cache lines of their own.
+
+The consumer only sleeps when the queue stays empty for a few yields, on a
+futex; a producer makes the wake up system call only if the consumer is
+actually asleep.
+
+offer() never blocks. A full queue discards the element being offered, as
+EventQueue's OVERFLOW_DROP_NEWEST does, and the caller still owns it.
+
+\param E - type of elements held in this collection; copied in and out.
+\param Producers - SingleProducer or MultiProducer.
+*/
+/**************************************************************************/
+
+template <class E, class Producers = SingleProducer>
+class RingQueue {
+public:
+	typedef enum {
+		OFFER_OK = 0,		/* Element queued */
+		OFFER_DROPPED,		/* Element not queued, counted as dropped */
+	} OfferStatus;
+
+/***************************************************************************/
+/*!
+\brief Constructor.
+Creates a RingQueue that holds at least the provided number of elements.
+
+\param cap - Number of elements that could be held in the queue, rounded up to
+a power of two.
+*/
+/**************************************************************************/
+
+	RingQueue(size_t cap = 32) : head(0), sleeping(0), tail(0), dropped(0) {
+		capacity = 1;
+		while (capacity < cap) {
+			capacity <<= 1;
+		}
+		mask = capacity - 1;
+
+		cells = new Cell[capacity];
+		for (size_t i = 0; i < capacity; i++) {
+			cells[i].seq.store(i, std::memory_order_relaxed);
+		}
+	}
+
+/***************************************************************************/
+/*!
+
+\brief Destructor
+Destructor - Destroys the RingQueue object.
+*/
+/**************************************************************************/
+
+	~RingQueue(void) {
+		if (size() != 0) {
+			printf("WARNING:  There are [%zu] elements left in queue\r\n", size());
+		}
+		delete [] cells;
+	}
+
+/***************************************************************************/
+/*!
+\brief method for polling events. This will block if queue is empty.
+
+Only one thread may poll. Unlike EventQueue::poll() it never returns without an
+element; a consumer that has to be stopped is sent a sentinel element.
+
+\return event from the front of the queue.
+*/
+/**************************************************************************/
+
+	E poll(void) {
+		E element;
+		int spins = 0;
+
+		for (;;) {
+			if (take(element)) {
+				return element;
+			}
+
+			/* A producer may have taken the slot but not filled it yet, or be about to offer; let it run */
+			if (size() != 0 || ++spins < SPINS_BEFORE_SLEEP) {
+				sched_yield();
+				continue;
+			}
+
+			/* Announce the sleep, then look again: an offer in between either shows up here or sees the flag */
+			sleeping.store(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (take(element)) {
+				sleeping.store(0, std::memory_order_relaxed);
+				return element;
+			}
+
+			/* Returns at once if an offer has already cleared the flag */
+			syscall(SYS_futex, (int *)&sleeping, FUTEX_WAIT_PRIVATE, 1, NULL, NULL, 0);
+		}
+	}
+
+/***************************************************************************/
+/*!
+\brief returns size of queue.
+
+Retrieves number of events currently available in the queue. Elements being
+offered concurrently may or may not be counted.
+
+\return number of events in queue.
+*/
+/**************************************************************************/
+
+	size_t size(void) const {
+		return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed);
+	}
+
+/***************************************************************************/
+/*!
+\brief send an event to the queue.
+
+Copies the element into the next free slot and wakes the consumer if it is
+asleep. Does not block.
+
+\param element - Object that is to be posted to the queue.
+\return OFFER_OK, or OFFER_DROPPED if the queue is full.
+*/
+/**************************************************************************/
+
+	OfferStatus offer(const E &element) {
+		size_t pos = tail.load(std::memory_order_relaxed);
+		Cell *cell;
+
+		for (;;) {
+			cell = &cells[pos & mask];
+			intptr_t diff = (intptr_t)cell->seq.load(std::memory_order_acquire) - (intptr_t)pos;
+
+			if (diff == 0) {
+				if (Producers::claim(tail, pos)) {
+					break;
+				}
+			}
+			else if (diff < 0) {
+				/* The slot still holds the element from one lap ago */
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return OFFER_DROPPED;
+			}
+			else {
+				pos = tail.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->value = element;
+		cell->seq.store(pos + 1, std::memory_order_release);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleeping.load(std::memory_order_relaxed) != 0 && sleeping.exchange(0) != 0) {
+			syscall(SYS_futex, (int *)&sleeping, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+		}
+
+		return OFFER_OK;
+	}
+
+/***************************************************************************/
+/*!
+\brief returns the number of events discarded because the queue was full.
+*/
+/**************************************************************************/
+
+	size_t getDroppedCount(void) const {
+		return dropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	enum {
+		CACHE_LINE = 64,
+		/* Yields on an empty queue before the consumer goes to sleep */
+		SPINS_BEFORE_SLEEP = 8,
+	};
+
+	struct Cell {
+		std::atomic<size_t> seq;
+		E value;
+	};
+
+	bool take(E &element) {
+		size_t pos = head.load(std::memory_order_relaxed);
+		Cell &cell = cells[pos & mask];
+
+		if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+			return false;
+		}
+
+		element = cell.value;
+		/* Hand the slot to the producer of the next lap */
+		cell.seq.store(pos + capacity, std::memory_order_release);
+		head.store(pos + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	Cell *cells;
+	size_t capacity;
+	size_t mask;
+
+	/* Padding rather than alignas, as the queue may be created with new */
+	char pad0[CACHE_LINE];
+	/* Consumer side */
+	std::atomic<size_t> head;
+	std::atomic<uint32_t> sleeping;
+	char pad1[CACHE_LINE];
+	/* Producer side */
+	std::atomic<size_t> tail;
+	std::atomic<size_t> dropped;
+	char pad2[CACHE_LINE];
+
+	RingQueue(const RingQueue &); /* Not allowed */
+	RingQueue & operator = (const RingQueue &); /* Not allowed */
+};
+
+CCEC_OSAL_END_NAMESPACE
+
+#endif
+
+
+/** @} */
+/** @} */
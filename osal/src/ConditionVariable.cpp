@@ -40,43 +40,35 @@
 
 CCEC_OSAL_BEGIN_NAMESPACE
 
-ConditionVariable::ConditionVariable() : cond(NULL), mutex(NULL), nativeHandle(NULL)
+ConditionVariable::ConditionVariable() : cond(false)
 {
-	cond = new  Condition(false);
-    mutex = new Mutex();
-    nativeHandle = Malloc(sizeof(pthread_cond_t));
-    pthread_cond_init( (pthread_cond_t *) nativeHandle, NULL );
+    pthread_cond_init( &nativeHandle, NULL );
 }
 
 ConditionVariable::~ConditionVariable()
 {
-	if (nativeHandle != NULL) {
-		pthread_cond_destroy((pthread_cond_t *) nativeHandle);
-		Free(nativeHandle);
-	}
-	delete mutex;
-	delete cond;
+	pthread_cond_destroy(&nativeHandle);
 }
 
 void ConditionVariable::set(void)
 {
-	mutex->lock();
-	cond->set();
-	mutex->unlock();
+	mutex.lock();
+	cond.set();
+	mutex.unlock();
 }
 
 void ConditionVariable::reset(void)
 {
-	mutex->lock();
-	cond->reset();
-	mutex->unlock();
+	mutex.lock();
+	cond.reset();
+	mutex.unlock();
 }
 
 bool ConditionVariable::isSet(void)
 {
-	mutex->lock();
-	bool set = cond->isSet();
-	mutex->unlock();
+	mutex.lock();
+	bool set = cond.isSet();
+	mutex.unlock();
 	return set;
 }
 
@@ -88,14 +80,14 @@ void ConditionVariable::wait(void)
 long ConditionVariable::wait(long timeout)
 {
     long timeLeft = 1;
-    mutex->lock();
+    mutex.lock();
 
     int ret = 0;
     if (timeout == 0) {
-        while (!cond->isSet()) {
+        while (!cond.isSet()) {
             ret = pthread_cond_wait(
-                (pthread_cond_t *)nativeHandle,
-                (pthread_mutex_t *)mutex->getNativeHandle()
+                &nativeHandle,
+                (pthread_mutex_t *)mutex.getNativeHandle()
             );
             if (ret < 0) {
                 // @TODO Throw Exception
@@ -111,48 +103,48 @@ long ConditionVariable::wait(long timeout)
         memset(&wakeTime, 0, sizeof(wakeTime));
         wakeTime.tv_nsec = curTime.tv_usec * 1000 + (timeout % 1000) * 1000000;
         wakeTime.tv_sec = curTime.tv_sec + (timeout / 1000);
-        if (wakeTime.tv_nsec > 1000000000) {
+        if (wakeTime.tv_nsec >= 1000000000) {
             wakeTime.tv_nsec -= 1000000000;
             wakeTime.tv_sec++;
         }
 
-        while (!cond->isSet()) {
+        while (!cond.isSet()) {
             ret = pthread_cond_timedwait(
-                (pthread_cond_t *)nativeHandle,
-                (pthread_mutex_t *)mutex->getNativeHandle(),
+                &nativeHandle,
+                (pthread_mutex_t *)mutex.getNativeHandle(),
                 &wakeTime
             );
 
-            if ((ret != 0) && !cond->isSet() && ret == ETIMEDOUT) {
+            if ((ret != 0) && !cond.isSet() && ret == ETIMEDOUT) {
                 timeLeft = 0;
                 break;
             }
         }
     }
 
-    mutex->unlock();
+    mutex.unlock();
     return timeLeft;
 }
 
 void ConditionVariable::notify(void)
 {
-	mutex->lock();
-	cond->set();
-	pthread_cond_signal((pthread_cond_t *)nativeHandle);
-	mutex->unlock();
+	mutex.lock();
+	cond.set();
+	pthread_cond_signal(&nativeHandle);
+	mutex.unlock();
 }
 
 void ConditionVariable::notifyAll(void)
 {
-	mutex->lock();
-	cond->set();
-	pthread_cond_broadcast((pthread_cond_t *)nativeHandle);
-	mutex->unlock();
+	mutex.lock();
+	cond.set();
+	pthread_cond_broadcast(&nativeHandle);
+	mutex.unlock();
 }
 
 void * ConditionVariable::getNativeHandle(void)
 {
-	return nativeHandle;
+	return &nativeHandle;
 }
 
 CCEC_OSAL_END_NAMESPACE
@@ -30,59 +30,58 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include <string.h>
-#include "safec_lib.h"
 #include "osal/Mutex.hpp"
 #include "osal/Util.hpp"
 
 CCEC_OSAL_BEGIN_NAMESPACE
 
-Mutex::Mutex(void) : nativeHandle(NULL)
+Mutex::Mutex(Type type) : type(type)
 {
-    pthread_mutexattr_t attr;
-    nativeHandle = Malloc(sizeof(pthread_mutex_t));
-    pthread_mutexattr_init( &attr);
-    pthread_mutexattr_settype (&attr, PTHREAD_MUTEX_RECURSIVE_NP);
-    pthread_mutex_init( (pthread_mutex_t *) nativeHandle, &attr );
-    pthread_mutexattr_destroy(&attr);
+    init();
 }
 
-Mutex::Mutex(const Mutex &rhs)
+Mutex::Mutex(const Mutex &rhs) : type(rhs.type)
 {
-    nativeHandle = Malloc(sizeof(pthread_mutex_t));
-    MEMCPY_S(nativeHandle,sizeof(pthread_mutex_t), rhs.nativeHandle, sizeof(pthread_mutex_t));
+    init();
 }
 
 Mutex & Mutex::operator = (const Mutex &rhs)
 {
-	Mutex temp(rhs);
-	void *tempHandle = temp.nativeHandle;
-	temp.nativeHandle = nativeHandle;
-	nativeHandle = tempHandle;
-
 	return *this;
 }
 
 Mutex::~Mutex(void)
 {
-	if (nativeHandle != NULL) {
-		pthread_mutex_destroy((pthread_mutex_t *) nativeHandle);
-		Free(nativeHandle);
-	}
+	pthread_mutex_destroy(&nativeHandle);
 }
 
-void Mutex::lock(void)
+void Mutex::init(void)
 {
-	pthread_mutex_lock((pthread_mutex_t *)nativeHandle);
-}
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init( &attr);
 
-void Mutex::unlock(void)
-{
-	pthread_mutex_unlock((pthread_mutex_t *)nativeHandle);
+    switch (type) {
+    case TYPE_RECURSIVE:
+        pthread_mutexattr_settype (&attr, PTHREAD_MUTEX_RECURSIVE);
+        break;
+    case TYPE_ADAPTIVE:
+#ifdef PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP
+        pthread_mutexattr_settype (&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+        break;
+#endif
+    case TYPE_NORMAL:
+    default:
+        pthread_mutexattr_settype (&attr, PTHREAD_MUTEX_NORMAL);
+        break;
+    }
+
+    pthread_mutex_init( &nativeHandle, &attr );
+    pthread_mutexattr_destroy(&attr);
 }
 
 void * Mutex::getNativeHandle(void)
 {
-	return nativeHandle;
+	return &nativeHandle;
 }
 
 CCEC_OSAL_END_NAMESPACE
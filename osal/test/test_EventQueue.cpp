@@ -28,11 +28,17 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#include <atomic>
+#include <vector>
 
 #include "osal/Thread.hpp"
 #include "osal/Runnable.hpp"
 #include "osal/EventQueue.hpp"
+#include "osal/RingQueue.hpp"
 
 using namespace CCEC_OSAL;
 
@@ -49,10 +55,12 @@ static EventQueue<Element *> *intQueue;
 
 class producer: public Runnable {
     void run(void) {
-        while(1) {
+        int last = 0;
+        while(last < 2000) {
             //sleep(2);
             Element *p = intQueue->poll();
             printf("Hello Producer got %d\r\n", p->value);
+            last = p->value;
             delete p;
         }
     }
@@ -70,15 +78,336 @@ class consumer: public Runnable {
     }
 };
 
+typedef EventQueue<Element *> ElementQueue;
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    printf("%s: %s\r\n", ok ? "PASS" : "FAIL", what);
+    if (!ok) failures++;
+}
+
+/* Fills a queue of 2 and offers a third element under each overflow policy */
+static void testOverflow(void)
+{
+    Element a(1), b(2), c(3);
+    Element *evicted = NULL;
+
+    {
+        ElementQueue queue(2, ElementQueue::OVERFLOW_DROP_NEWEST);
+        queue.offer(&a);
+        queue.offer(&b);
+        check(queue.offer(&c) == ElementQueue::OFFER_DROPPED, "drop newest reports the drop");
+        check(queue.poll() == &a && queue.poll() == &b, "drop newest keeps the queued elements");
+        check(queue.getDroppedCount() == 1 && queue.getHighWaterMark() == 2, "drop newest counts");
+    }
+    {
+        ElementQueue queue(2, ElementQueue::OVERFLOW_DROP_OLDEST);
+        queue.offer(&a);
+        queue.offer(&b);
+        check(queue.offer(&c, &evicted) == ElementQueue::OFFER_DROPPED_OLDEST, "drop oldest reports the drop");
+        check(evicted == &a, "drop oldest hands back the oldest element");
+        check(queue.poll() == &b && queue.poll() == &c, "drop oldest keeps the newest elements");
+        check(queue.getDroppedCount() == 1, "drop oldest counts");
+    }
+    {
+        ElementQueue queue(2, ElementQueue::OVERFLOW_REJECT);
+        queue.offer(&a);
+        queue.offer(&b);
+        check(queue.offer(&c) == ElementQueue::OFFER_REJECTED, "reject reports the rejection");
+        check(queue.size() == 2 && queue.getRejectedCount() == 1 && queue.getDroppedCount() == 0, "reject counts");
+        queue.poll();
+        queue.poll();
+    }
+    {
+        ElementQueue queue(2, ElementQueue::OVERFLOW_BLOCK, 100);
+        queue.offer(&a);
+        queue.offer(&b);
+        check(queue.offer(&c) == ElementQueue::OFFER_TIMED_OUT, "block times out on a full queue");
+        check(queue.getRejectedCount() == 1, "block counts the time out");
+        queue.poll();
+        queue.poll();
+    }
+}
+
+class drainer: public Runnable {
+public:
+    drainer(ElementQueue &queue) : queue(queue) {}
+    void run(void) {
+        sleep(1);
+        queue.poll();
+    }
+private:
+    ElementQueue &queue;
+};
+
+/* A blocked offer goes through once the consumer makes space */
+static void testBlock(void)
+{
+    Element a(1), b(2), c(3);
+    ElementQueue queue(2, ElementQueue::OVERFLOW_BLOCK);
+
+    queue.offer(&a);
+    queue.offer(&b);
+    Thread(*(new drainer(queue))).start();
+    check(queue.offer(&c) == ElementQueue::OFFER_OK, "block waits for space");
+    check(queue.poll() == &b && queue.poll() == &c, "block keeps the order");
+}
+
+/* Timed and non blocking polls, and taking a burst at once */
+static void testPoll(void)
+{
+    Element a(1), b(2), c(3);
+    Element *element = NULL;
+    ElementQueue queue(8);
+
+    check(!queue.tryPoll(element), "try poll on an empty queue takes nothing");
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool taken = queue.poll(element, 100);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    long waited = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+    check(!taken && waited >= 90, "timed poll times out on an empty queue");
+
+    queue.offer(&a);
+    check(queue.poll(element, 100) && element == &a, "timed poll takes a queued element");
+    queue.offer(&b);
+    check(queue.tryPoll(element) && element == &b, "try poll takes a queued element");
+
+    queue.offer(&a);
+    queue.offer(&b);
+    queue.offer(&c);
+    std::vector<Element *> burst;
+    check(queue.drainTo(burst, 2) == 2 && burst[0] == &a && burst[1] == &b, "drain takes up to max elements in order");
+    check(queue.drainTo(burst, 8) == 1 && burst[2] == &c && queue.size() == 0, "drain takes what is left");
+    check(!queue.poll(element, 10), "a drained queue is empty");
+}
+
+/* Polls until it gets the NULL sentinel */
+class poller: public Runnable {
+public:
+    poller(ElementQueue &queue, std::atomic<int> &taken, std::atomic<int> &stopped)
+        : queue(queue), taken(taken), stopped(stopped) {}
+    void run(void) {
+        while (queue.poll() != NULL) {
+            taken++;
+        }
+        stopped++;
+    }
+private:
+    ElementQueue &queue;
+    std::atomic<int> &taken;
+    std::atomic<int> &stopped;
+};
+
+/* Several consumers on one queue get every element and no empty polls */
+static void testConsumers(void)
+{
+    const int consumers = 4;
+    const int count = 4000;
+    Element a(1);
+    std::atomic<int> taken(0), stopped(0);
+    ElementQueue queue(32, ElementQueue::OVERFLOW_BLOCK);
+
+    for (int i = 0; i < consumers; i++) {
+        Thread(*(new poller(queue, taken, stopped))).start();
+    }
+    for (int i = 0; i < count; i++) {
+        queue.offer(&a);
+    }
+    for (int i = 0; i < consumers; i++) {
+        queue.offer(NULL);
+    }
+    for (int i = 0; i < 1000 && stopped.load() != consumers; i++) {
+        usleep(10 * 1000);
+    }
+
+    check(stopped.load() == consumers, "every consumer gets its sentinel");
+    check(taken.load() == count && queue.size() == 0, "consumers share the elements without empty polls");
+}
+
+typedef RingQueue<intptr_t, SingleProducer> SpscRing;
+typedef RingQueue<intptr_t, MultiProducer> MpscRing;
+
+/* Offers 1..count, retrying while the queue is full */
+template <class Q>
+class sender: public Runnable {
+public:
+    sender(Q &queue, intptr_t count, std::atomic<int> &done) : queue(queue), count(count), done(done) {}
+    void run(void) {
+        for (intptr_t i = 1; i <= count; i++) {
+            while (queue.offer(i) != Q::OFFER_OK) {
+                sched_yield();
+            }
+        }
+        done++;
+    }
+private:
+    Q &queue;
+    intptr_t count;
+    std::atomic<int> &done;
+};
+
+static void testRing(void)
+{
+    {
+        SpscRing ring(3);
+        check(ring.offer(1) == SpscRing::OFFER_OK && ring.offer(2) == SpscRing::OFFER_OK &&
+              ring.offer(3) == SpscRing::OFFER_OK && ring.offer(4) == SpscRing::OFFER_OK, "ring rounds the capacity up");
+        check(ring.offer(5) == SpscRing::OFFER_DROPPED && ring.getDroppedCount() == 1, "full ring drops the newest");
+        check(ring.poll() == 1 && ring.poll() == 2 && ring.poll() == 3 && ring.poll() == 4 && ring.size() == 0,
+              "ring keeps the order");
+    }
+    {
+        const intptr_t count = 100000;
+        std::atomic<int> done(0);
+        MpscRing ring(16);
+        Thread(*(new sender<MpscRing>(ring, count, done))).start();
+        Thread(*(new sender<MpscRing>(ring, count, done))).start();
+
+        long long sum = 0;
+        bool ordered = true;
+        intptr_t last[2] = {0, 0};
+        for (intptr_t i = 0; i < 2 * count; i++) {
+            intptr_t value = ring.poll();
+            sum += value;
+            /* Each sender's elements arrive in order; one of the two lasts must be just behind */
+            if (value == last[0] + 1) last[0] = value;
+            else if (value == last[1] + 1) last[1] = value;
+            else ordered = false;
+        }
+        check(sum == (long long)count * (count + 1), "mpsc ring delivers every element once");
+        check(ordered, "mpsc ring keeps the order of each producer");
+        while (done.load() != 2) usleep(1000);
+    }
+}
+
+static long long nowUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Sends each element back on another queue, until it gets 0 */
+template <class Q>
+class echo: public Runnable {
+public:
+    echo(Q &in, Q &out) : in(in), out(out) {}
+    void run(void) {
+        intptr_t value;
+        do {
+            value = in.poll();
+            out.offer(value);
+        } while (value != 0);
+    }
+private:
+    Q &in;
+    Q &out;
+};
+
+/*
+ * Throughput: producers stream count elements each through the queue.
+ * Latency: one element at a time goes to an echo thread and back.
+ */
+template <class Q>
+static void bench(const char *name, Q &queue, Q &ping, Q &pong, int producers)
+{
+    const intptr_t count = 200000;
+    const int rounds = 20000;
+    std::atomic<int> done(0);
+
+    long long start = nowUs();
+    for (int i = 0; i < producers; i++) {
+        Thread(*(new sender<Q>(queue, count, done))).start();
+    }
+    for (intptr_t i = 0; i < producers * count; i++) {
+        queue.poll();
+    }
+    long long streamed = nowUs() - start;
+    while (done.load() != producers) usleep(1000);
+
+    Thread(*(new echo<Q>(ping, pong))).start();
+    start = nowUs();
+    for (int i = 1; i <= rounds; i++) {
+        ping.offer(i);
+        pong.poll();
+    }
+    long long echoed = nowUs() - start;
+    ping.offer(0);
+    pong.poll();
+
+    printf("%-26s %d producer(s): %8.0f elements/s, round trip %6.2f us\r\n", name, producers,
+           (double)producers * count * 1000000 / streamed, (double)echoed / rounds);
+}
+
+/* Throughput of an EventQueue consumer that takes the rest of each burst with drainTo() */
+static void benchDrain(void)
+{
+    const intptr_t count = 200000;
+    std::atomic<int> done(0);
+    EventQueue<intptr_t> queue(256, EventQueue<intptr_t>::OVERFLOW_BLOCK);
+    std::vector<intptr_t> burst;
+    burst.reserve(64);
+
+    long long start = nowUs();
+    Thread(*(new sender<EventQueue<intptr_t> >(queue, count, done))).start();
+    for (intptr_t taken = 0; taken < count; ) {
+        intptr_t value;
+        if (queue.poll(value, 0)) {
+            burst.clear();
+            taken += 1 + queue.drainTo(burst, 64);
+        }
+    }
+    long long streamed = nowUs() - start;
+    while (done.load() != 1) usleep(1000);
+
+    printf("%-26s %d producer(s): %8.0f elements/s\r\n", "EventQueue with drainTo", 1,
+           (double)count * 1000000 / streamed);
+}
+
+static void benchQueues(void)
+{
+    {
+        EventQueue<intptr_t> queue(256, EventQueue<intptr_t>::OVERFLOW_BLOCK), ping(4), pong(4);
+        bench("EventQueue", queue, ping, pong, 1);
+    }
+    benchDrain();
+    {
+        SpscRing queue(256), ping(4), pong(4);
+        bench("RingQueue<SingleProducer>", queue, ping, pong, 1);
+    }
+    {
+        EventQueue<intptr_t> queue(256, EventQueue<intptr_t>::OVERFLOW_BLOCK), ping(4), pong(4);
+        bench("EventQueue", queue, ping, pong, 2);
+    }
+    {
+        MpscRing queue(256), ping(4), pong(4);
+        bench("RingQueue<MultiProducer>", queue, ping, pong, 2);
+    }
+}
+
 int main() 
 {
-    intQueue = new EventQueue<Element *>();
+    testOverflow();
+    testBlock();
+    testPoll();
+    testConsumers();
+    testRing();
+    benchQueues();
+
+    /* Block the sender while the queue is full, so that every element arrives */
+    intQueue = new EventQueue<Element *>(32, ElementQueue::OVERFLOW_BLOCK);
     consumer *con;
     producer *pro;
     Thread(*(new consumer())).start();
     Thread(*(new producer())).start();
     sleep(10);
     delete intQueue;
+
+    return failures;
 }
 
 
@@ -0,0 +1,245 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup tests
+* @{
+**/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <atomic>
+#include <new>
+
+#include "ccec/CECFrame.hpp"
+#include "ccec/Connection.hpp"
+#include "ccec/FrameListener.hpp"
+#include "ccec/Header.hpp"
+#include "ccec/LibCCEC.hpp"
+#include "ccec/Messages.hpp"
+#include "ccec/MessageDecoder.hpp"
+#include "ccec/MessageEncoder.hpp"
+#include "ccec/MessageProcessor.hpp"
+#include "ccec/Util.hpp"
+
+#include "LoopbackHal.hpp"
+
+/*
+ * Counts heap allocations made while encoding, decoding and filtering
+ * frames. The steady state paths are expected to make none. Received frames
+ * are filtered by real Connections, fed through LoopbackHal, so allocations
+ * on the library's receive path are counted as well.
+ * Runs against LoopbackHal, no CEC bus needed; run with no arguments.
+ */
+
+static const int ITERATIONS = 1000;
+static const int DISPATCH_TIMEOUT_US = 1000000;
+
+static std::atomic<bool> counting(false);
+static std::atomic<unsigned long> allocations(0);
+
+void *operator new(size_t size)
+{
+    if (counting) allocations++;
+    void *p = malloc(size ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    if (counting) allocations++;
+    void *p = malloc(size ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+/* Consumes the decoded messages without printing them */
+class CountingProcessor : public MessageProcessor
+{
+public:
+    CountingProcessor(void) : count(0) {}
+    void process(const ActiveSource &msg, const Header &header) { count += msg.physicalAddress.getByteValue(0); }
+    void process(const Standby &msg, const Header &header) { count += header.from.toInt(); }
+    void process(const ReportPhysicalAddress &msg, const Header &header) { count += msg.physicalAddress.getByteValue(0); }
+    void process(const SetOSDName &msg, const Header &header) { count += header.to.toInt(); }
+    void process(const DeviceVendorID &msg, const Header &header) { count++; }
+    void process(const ReportPowerStatus &msg, const Header &header) { count += msg.status.toInt(); }
+    void process(const FeatureAbort &msg, const Header &header) { count += msg.reason.toInt(); }
+    void process(const UserControlPressed &msg, const Header &header) { count += msg.uiCommand.toInt(); }
+    void process(const Polling &msg, const Header &header) { count++; }
+    unsigned long count;
+};
+
+static bool check(const char *name, unsigned long count)
+{
+    printf("%-40s %6lu allocations %s\n", name, count, count ? "FAIL" : "PASS");
+    return count == 0;
+}
+
+static unsigned long encodeFrames(int iterations)
+{
+    unsigned long before = allocations;
+    for (int i = 0; i < iterations; i++) {
+        CECFrame frame;
+        Header header(LogicalAddress(LogicalAddress::TUNER_1), LogicalAddress(LogicalAddress::BROADCAST));
+        MessageEncoder::encode(header, ActiveSource(PhysicalAddress(3, 0, 0, 0)), frame);
+
+        CECFrame report;
+        MessageEncoder::encode(header, ReportPhysicalAddress(PhysicalAddress(3, 0, 0, 0), DeviceType(DeviceType::TUNER)), report);
+
+        CECFrame name;
+        MessageEncoder::encode(Header(LogicalAddress(LogicalAddress::TUNER_1), LogicalAddress(LogicalAddress::TV)),
+                               SetOSDName(OSDName("Living Room")), name);
+
+        CECFrame power;
+        MessageEncoder::encode(Header(LogicalAddress(LogicalAddress::TUNER_1), LogicalAddress(LogicalAddress::TV)),
+                               ReportPowerStatus(PowerStatus(PowerStatus::ON)), power);
+    }
+    return allocations - before;
+}
+
+static unsigned long decodeFrames(int iterations, CountingProcessor &processor)
+{
+    /* First byte of each row is the frame length */
+    static const uint8_t frames[][6] = {
+        {4, 0x4F, 0x82, 0x10, 0x00},
+        {5, 0x3F, 0x84, 0x30, 0x00, 0x03},
+        {4, 0x04, 0x47, 'T', 'V'},
+        {2, 0x0F, 0x36},
+        {5, 0x0F, 0x87, 0x00, 0x00, 0x08},
+        {3, 0x40, 0x90, 0x01},
+        {4, 0x40, 0x00, 0x8F, 0x03},
+        {3, 0x40, 0x44, 0x41},
+        {1, 0x44},
+    };
+    unsigned long before = allocations;
+    for (int i = 0; i < iterations; i++) {
+        for (size_t j = 0; j < sizeof(frames) / sizeof(frames[0]); j++) {
+            CECFrame frame(&frames[j][1], frames[j][0]);
+            MessageDecoder(processor).decode(frame);
+        }
+    }
+    return allocations - before;
+}
+
+/* Counts the frames a Connection hands to its listeners */
+class CountingListener : public FrameListener {
+public:
+    CountingListener(void) : count(0) {}
+    void notify(const CECFrame &frame) const { count++; }
+    mutable std::atomic<unsigned long> count;
+};
+
+/* Hands frame to the library as if it came off the bus, and waits until it has been dispatched */
+static bool receive(const uint8_t *frame, int length, CountingListener &last)
+{
+    unsigned long expected = last.count.load() + 1;
+    uint64_t received = GetMonotonicTimeUs();
+
+    LoopbackHal::getInstance().receive(frame, length);
+    while (last.count.load() < expected) {
+        if (GetMonotonicTimeUs() - received > (uint64_t)DISPATCH_TIMEOUT_US) {
+            return false;
+        }
+        usleep(100);
+    }
+    return true;
+}
+
+/*
+ * Runs received frames through Connection's own FrameListener and filter, for
+ * a Connection with a logical address and for an UNREGISTERED one, which
+ * takes every frame. The UNREGISTERED Connection is opened last, so its
+ * listener tells when the dispatch of a frame is over.
+ */
+static unsigned long filterFrames(int iterations, CountingListener &mine, CountingListener &all)
+{
+    /* TV to Playback Device 1, TV to Audio System, TV to all: <Standby> */
+    static const uint8_t toMine[] = {0x04, 0x36};
+    static const uint8_t toOther[] = {0x05, 0x36};
+    static const uint8_t toAll[] = {0x0F, 0x36};
+    unsigned long mineBefore = mine.count.load();
+    unsigned long allBefore = all.count.load();
+    bool dispatched = true;
+
+    unsigned long before = allocations;
+    for (int i = 0; i < iterations; i++) {
+        dispatched &= receive(toMine, sizeof(toMine), all);
+        dispatched &= receive(toOther, sizeof(toOther), all);
+        dispatched &= receive(toAll, sizeof(toAll), all);
+    }
+    unsigned long count = allocations - before;
+
+    unsigned long delivered = mine.count.load() - mineBefore;
+    unsigned long taken = all.count.load() - allBefore;
+    if (!dispatched || delivered != 2 * (unsigned long)iterations || taken != 3 * (unsigned long)iterations) {
+        printf("Unexpected filter result %lu/%lu\n", delivered, taken);
+        return count + 1;
+    }
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    CountingProcessor processor;
+    CountingListener mine, all;
+    bool passed = true;
+
+    LibCCEC::getInstance().init("CECAllocTest");
+    Connection playback(LogicalAddress(LogicalAddress::PLAYBACK_DEVICE_1), false, "CECAllocTest playback");
+    Connection unregistered(LogicalAddress(LogicalAddress::UNREGISTERED), false, "CECAllocTest unregistered");
+    playback.open();
+    playback.addFrameListener(&mine);
+    unregistered.open();
+    unregistered.addFrameListener(&all);
+
+    /* Warm up once so one-time static initialization is not counted */
+    encodeFrames(1);
+    decodeFrames(1, processor);
+    filterFrames(1, mine, all);
+
+    counting = true;
+    passed &= check("encode", encodeFrames(ITERATIONS));
+    passed &= check("decode", decodeFrames(ITERATIONS, processor));
+    passed &= check("filter", filterFrames(ITERATIONS, mine, all));
+    counting = false;
+
+    unregistered.removeFrameListener(&all);
+    unregistered.close();
+    playback.removeFrameListener(&mine);
+    playback.close();
+    LibCCEC::getInstance().term();
+
+    return passed ? 0 : 1;
+}
+
+
+/** @} */
+/** @} */
@@ -0,0 +1,583 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup tests
+* @{
+**/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ccec/CECFrame.hpp"
+#include "ccec/Messages.hpp"
+#include "ccec/MessageEncoder.hpp"
+#include "ccec/ResponseCache.hpp"
+#include "ccec/MessageDecoder.hpp"
+#include "ccec/MessageProcessor.hpp"
+#include "ccec/StaticMessageDecoder.hpp"
+#include "ccec/Exception.hpp"
+#include "ccec/LibCCEC.hpp"
+#include "ccec/Connection.hpp"
+#include "ccec/Util.hpp"
+
+/*
+ * Micro benchmarks for the frame, encode and decode paths.
+ * None of them touch the CEC bus; run with no arguments.
+ *
+ * "CECBenchmark bus" additionally opens the driver and
+ *  - times a scan of all logical addresses, once through the throwing and once
+ *    through the non-throwing ping,
+ *  - queues a burst of background frames followed by interactive ones, waits
+ *    on their completion handles and reports the queue wait and outcome of
+ *    both priority classes,
+ *  - keeps queueing async frames while a sync send to an absent address is
+ *    being retried, and reports how long they took,
+ *  - times a burst of volume key repeats with and without coalescing,
+ *  - times frames to the TV queued behind frames to an absent device.
+ */
+
+static const int ITERATIONS = 1000000;
+
+static double nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void report(const char *name, double startNs, int iterations)
+{
+    printf("%-48s %10.1f ns/op\n", name, (nowNs() - startNs) / iterations);
+}
+
+/* Keeps the optimizer from discarding benchmark results */
+static volatile uint8_t sink;
+
+/*
+ * Replica of the frame layout used before the frame was sized to the CEC
+ * maximum (128 byte buffer, size_t length, per-byte append).
+ */
+class LegacyFrame {
+public:
+    LegacyFrame(void) : len_(0) {}
+    void append(uint8_t byte) {
+        if (len_ == sizeof(buf_)) throw std::out_of_range("Frame grows beyond maximum");
+        buf_[len_++] = byte;
+    }
+    void append(const uint8_t *buf, size_t len) {
+        for (size_t i = 0; i < len; i++) append(buf[i]);
+    }
+    LegacyFrame subFrame(size_t start) const {
+        LegacyFrame frame;
+        while (start < len_) frame.append(buf_[start++]);
+        return frame;
+    }
+    uint8_t at(size_t i) const { return buf_[i]; }
+private:
+    uint8_t buf_[128];
+    size_t len_;
+};
+
+template <class Frame>
+static void benchFrame(const char *label)
+{
+    /* <Report Physical Address> 3.0.0.0 from Tuner 1, broadcast */
+    static const uint8_t bytes[] = {0x3F, 0x84, 0x30, 0x00, 0x03};
+    static Frame queue[32];
+    char name[64];
+    double start;
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        Frame frame;
+        frame.append(bytes, sizeof(bytes));
+        queue[i & 31] = frame;
+    }
+    snprintf(name, sizeof(name), "%s build+enqueue", label);
+    report(name, start, ITERATIONS);
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        sink = queue[i & 31].subFrame(2).at(0);
+    }
+    snprintf(name, sizeof(name), "%s subFrame(2)", label);
+    report(name, start, ITERATIONS);
+}
+
+static void benchFrames(void)
+{
+    printf("== CECFrame footprint ==\n");
+    printf("%-48s %10zu bytes\n", "legacy frame", sizeof(LegacyFrame));
+    printf("%-48s %10zu bytes\n", "CECFrame", sizeof(CECFrame));
+    printf("%-48s %10zu bytes\n", "legacy 32-deep queue", 32 * sizeof(LegacyFrame));
+    printf("%-48s %10zu bytes\n", "CECFrame 32-deep queue", 32 * sizeof(CECFrame));
+
+    printf("== CECFrame throughput ==\n");
+    benchFrame<LegacyFrame>("legacy frame");
+    benchFrame<CECFrame>("CECFrame");
+}
+
+static bool sameFrame(const CECFrame &a, const CECFrame &b)
+{
+    return (a.length() == b.length()) && (memcmp(a.getBuffer(), b.getBuffer(), a.length()) == 0);
+}
+
+/* The compile-time encoding must produce exactly what MessageEncoder produces */
+template <class M>
+static bool checkConstantEncoding(const char *label)
+{
+    for (int from = 0; from <= LogicalAddress::BROADCAST; from++) {
+        for (int to = 0; to <= LogicalAddress::BROADCAST; to++) {
+            CECFrame expected = MessageEncoder::encode(Header(LogicalAddress(from), LogicalAddress(to)), M());
+            CECFrame actual = MessageEncoder::encode<M>(LogicalAddress(from), LogicalAddress(to));
+            if (!sameFrame(expected, actual)) {
+                printf("%-48s MISMATCH from %d to %d\n", label, from, to);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void benchEncode(void)
+{
+    LogicalAddress from(LogicalAddress::TUNER_1);
+    LogicalAddress to(LogicalAddress::TV);
+    double start;
+    bool same = true;
+
+    same &= checkConstantEncoding<ImageViewOn>("ImageViewOn");
+    same &= checkConstantEncoding<TextViewOn>("TextViewOn");
+    same &= checkConstantEncoding<Standby>("Standby");
+    same &= checkConstantEncoding<GiveDevicePowerStatus>("GiveDevicePowerStatus");
+    same &= checkConstantEncoding<GivePhysicalAddress>("GivePhysicalAddress");
+    same &= checkConstantEncoding<GetCECVersion>("GetCECVersion");
+    same &= checkConstantEncoding<GiveOSDName>("GiveOSDName");
+    same &= checkConstantEncoding<Abort>("Abort");
+    same &= checkConstantEncoding<Polling>("Polling");
+
+    printf("== Constant message encode (%s) ==\n", same ? "identical bytes" : "MISMATCH");
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        CECFrame frame = MessageEncoder::encode(Header(from, to), ImageViewOn());
+        sink = frame.at(1);
+    }
+    report("MessageEncoder::encode(Header, ImageViewOn)", start, ITERATIONS);
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        CECFrame frame = MessageEncoder::encode<ImageViewOn>(from, to);
+        sink = frame.at(1);
+    }
+    report("MessageEncoder::encode<ImageViewOn>(from, to)", start, ITERATIONS);
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        CECFrame frame = MessageEncoder::encode<ImageViewOn, LogicalAddress::TUNER_1, LogicalAddress::TV>();
+        sink = frame.at(1);
+    }
+    report("MessageEncoder::encode<ImageViewOn, 3, 0>()", start, ITERATIONS);
+}
+
+static void benchResponseCache(void)
+{
+    LogicalAddress from(LogicalAddress::TUNER_1);
+    LogicalAddress to(LogicalAddress::BROADCAST);
+    ResponseCache cache;
+    CECFrame frame;
+    double start;
+
+    printf("== Reply encode vs response cache ==\n");
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        CECFrame reply = MessageEncoder::encode(Header(from, to),
+                ReportPhysicalAddress(PhysicalAddress(3, 0, 0, 0), DeviceType(DeviceType::TUNER)));
+        sink = reply.at(2);
+    }
+    report("encode <Report Physical Address>", start, ITERATIONS);
+
+    cache.put(MessageEncoder::encode(Header(from, to),
+                ReportPhysicalAddress(PhysicalAddress(3, 0, 0, 0), DeviceType(DeviceType::TUNER))),
+              cache.getGeneration(REPORT_PHYSICAL_ADDRESS));
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        cache.get(REPORT_PHYSICAL_ADDRESS, from, to, frame);
+        sink = frame.at(2);
+    }
+    report("ResponseCache::get <Report Physical Address>", start, ITERATIONS);
+}
+
+/* Consumes decoded messages without the DEBUG printing of the default processor */
+class SilentProcessor : public MessageProcessor
+{
+public:
+    void process(const ActiveSource &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const Standby &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const ReportPhysicalAddress &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const SetOSDName &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const DeviceVendorID &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const GiveDevicePowerStatus &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const ReportPowerStatus &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const UserControlPressed &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const UserControlReleased &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const Polling &msg, const Header &header) { sink = header.from.toInt(); }
+};
+
+/* Same processor, declaring that it only handles <Active Source> and <Standby> */
+class NarrowProcessor : public SilentProcessor
+{
+public:
+    NarrowProcessor(void) {
+        interest.reset();
+        interest.set(ACTIVE_SOURCE);
+        interest.set(STANDBY);
+    }
+};
+
+/* Plain class with non-virtual overloads, for StaticMessageDecoder */
+class StaticProcessor
+{
+public:
+    void process(const ActiveSource &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const Standby &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const ReportPhysicalAddress &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const SetOSDName &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const DeviceVendorID &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const GiveDevicePowerStatus &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const ReportPowerStatus &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const UserControlPressed &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const UserControlReleased &msg, const Header &header) { sink = header.from.toInt(); }
+    void process(const Polling &msg, const Header &header) { sink = header.from.toInt(); }
+};
+
+class VendorCommandHandler : public OpCodeHandler
+{
+public:
+    void process(const CECFrameView &operands, const Header &header) { sink = operands.at(0); }
+};
+
+static void benchDecode(void)
+{
+    /* Typical traffic: remote keys dominate, then power and discovery. First byte is the length */
+    static const uint8_t frames[][7] = {
+        {3, 0x04, 0x44, 0x01},
+        {2, 0x04, 0x45},
+        {3, 0x04, 0x44, 0x02},
+        {2, 0x04, 0x45},
+        {2, 0x04, 0x8F},
+        {3, 0x40, 0x90, 0x00},
+        {4, 0x0F, 0x82, 0x10, 0x00},
+        {5, 0x0F, 0x84, 0x00, 0x00, 0x00},
+        {5, 0x0F, 0x87, 0x00, 0x00, 0xF0},
+        {5, 0x04, 0x47, 'T', 'V', ' '},
+        {1, 0x44},
+        {4, 0x04, 0x89, 0x01, 0x02},
+        {2, 0x0F, 0x36},
+    };
+    const int count = sizeof(frames) / sizeof(frames[0]);
+    CECFrame mix[count];
+    SilentProcessor processor;
+    VendorCommandHandler vendor;
+    double start;
+
+    for (int i = 0; i < count; i++) {
+        mix[i] = CECFrame(&frames[i][1], frames[i][0]);
+    }
+
+    printf("== Decode ==\n");
+    MessageDecoder::registerHandler(VENDOR_COMMAND, &vendor);
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        MessageDecoder(processor).decode(mix[i % count]);
+    }
+    report("MessageDecoder::decode, mixed opcodes", start, ITERATIONS);
+
+    NarrowProcessor narrow;
+    MessageDecoder::registerHandler(VENDOR_COMMAND, NULL);
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        MessageDecoder(narrow).decode(mix[i % count]);
+    }
+    report("MessageDecoder::decode, 2 opcodes of interest", start, ITERATIONS);
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        StaticMessageDecoder<MessageProcessor>(processor).decode(mix[i % count]);
+    }
+    report("StaticMessageDecoder<MessageProcessor>::decode", start, ITERATIONS);
+
+    StaticProcessor direct;
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        StaticMessageDecoder<StaticProcessor>(direct).decode(mix[i % count]);
+    }
+    report("StaticMessageDecoder<StaticProcessor>::decode", start, ITERATIONS);
+
+    /* A misbehaving TV: truncated operands and broadcasts of directed opcodes */
+    static const uint8_t malformed[][5] = {
+        {2, 0x0F, 0x82},
+        {3, 0x0F, 0x84, 0x10},
+        {4, 0x04, 0x82, 0x10, 0x00},
+        {2, 0x04, 0x44},
+    };
+    const int bad = sizeof(malformed) / sizeof(malformed[0]);
+    CECFrame burst[bad];
+
+    for (int i = 0; i < bad; i++) {
+        burst[i] = CECFrame(&malformed[i][1], malformed[i][0]);
+    }
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        sink = MessageDecoder(processor).tryDecode(burst[i % bad]);
+    }
+    report("MessageDecoder::tryDecode, malformed frames", start, ITERATIONS);
+
+    CECFrame empty;
+    CECFrameView none(empty);
+    PhysicalAddress address(0x0F, 0x0F, 0x0F, 0x0F);
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        try {
+            address = PhysicalAddress(none, 0);
+        }
+        catch (InvalidParamException &e) {
+            sink = 1;
+        }
+    }
+    report("PhysicalAddress from missing operand, throw", start, ITERATIONS);
+
+    start = nowNs();
+    for (int i = 0; i < ITERATIONS; i++) {
+        sink = PhysicalAddress::parse(none, 0, address);
+    }
+    report("PhysicalAddress::parse, missing operand", start, ITERATIONS);
+}
+
+static void benchScan(Connection &connection)
+{
+    const int SCANS = 100;
+    LogicalAddress from(LogicalAddress::PLAYBACK_DEVICE_1);
+    double start;
+    int present = 0;
+
+    printf("== Bus scan, 14 pings per scan ==\n");
+
+    start = nowNs();
+    for (int i = 0; i < SCANS; i++) {
+        for (int to = LogicalAddress::TV; to < LogicalAddress::BROADCAST; to++) {
+            if (to == from.toInt()) continue;
+            try {
+                connection.ping(from, LogicalAddress(to), Throw_e());
+                present++;
+            }
+            catch (Exception &e) {
+            }
+        }
+    }
+    report("Connection::ping, throw on NACK", start, SCANS);
+
+    start = nowNs();
+    for (int i = 0; i < SCANS; i++) {
+        for (int to = LogicalAddress::TV; to < LogicalAddress::BROADCAST; to++) {
+            if (to == from.toInt()) continue;
+            if (connection.tryPing(from, LogicalAddress(to)) == SEND_ACKED) {
+                present++;
+            }
+        }
+    }
+    report("Connection::tryPing", start, SCANS);
+    sink = present;
+}
+
+static void reportWait(const char *name, TxPriority priority, const std::vector<TxCompletion> &completions)
+{
+    TxQueueStats stats;
+    int acked = 0;
+    uint64_t totalUs = 0;
+
+    for (size_t i = 0; i < completions.size(); i++) {
+        acked += (completions[i].getResult() == SEND_ACKED);
+        totalUs += completions[i].getCompletedTime() - completions[i].getQueuedTime();
+    }
+
+    LibCCEC::getInstance().getTxQueueStats(priority, stats);
+    printf("%-24s %4u frames, queue wait avg %8.1f us, max %8llu us, %d ACKed, done after avg %8.1f us\n",
+           name, stats.frames, stats.frames ? (double)stats.totalWaitUs / stats.frames : 0.0,
+           (unsigned long long)stats.maxWaitUs, acked, completions.empty() ? 0.0 : (double)totalUs / completions.size());
+}
+
+static void benchTxPriority(Connection &connection)
+{
+    const int BACKGROUND = 50;
+    const int INTERACTIVE = 10;
+    std::vector<TxCompletion> background, interactive;
+
+    printf("== Async queue wait, %d background frames then %d key presses ==\n", BACKGROUND, INTERACTIVE);
+
+    /* All frames are outstanding at once; this thread only waits for the handles */
+    for (int i = 0; i < BACKGROUND; i++) {
+        background.push_back(connection.sendToAsync(LogicalAddress::SPECIFIC_USE, MessageEncoder().encode(GiveOSDName()), TX_PRIORITY_BACKGROUND));
+    }
+    for (int i = 0; i < INTERACTIVE; i++) {
+        interactive.push_back(connection.sendToAsync(LogicalAddress::TV, MessageEncoder().encode(UserControlPressed(UICommand(UICommand::UI_COMMAND_SELECT))), TX_PRIORITY_INTERACTIVE));
+    }
+
+    for (size_t i = 0; i < background.size(); i++) {
+        background[i].wait();
+    }
+    for (size_t i = 0; i < interactive.size(); i++) {
+        interactive[i].wait();
+    }
+
+    reportWait("TX_PRIORITY_INTERACTIVE", TX_PRIORITY_INTERACTIVE, interactive);
+    reportWait("TX_PRIORITY_BACKGROUND", TX_PRIORITY_BACKGROUND, background);
+}
+
+static void benchRetry(Connection &connection)
+{
+    const int FRAMES = 20;
+    std::vector<TxCompletion> frames;
+    uint64_t maxUs = 0;
+
+    printf("== Async frames while a sync send retries for 1 s ==\n");
+
+    std::thread sender([&connection]() {
+        uint64_t start = GetMonotonicTimeUs();
+        SendResult result = connection.trySendTo(LogicalAddress::SPECIFIC_USE, MessageEncoder().encode(GiveOSDName()), 1000);
+        printf("%-24s %s after %llu ms\n", "sync send, timeout 1000", GetSendResultName(result),
+               (unsigned long long)(GetMonotonicTimeUs() - start) / 1000);
+    });
+
+    for (int i = 0; i < FRAMES; i++) {
+        usleep(40 * 1000);
+        frames.push_back(connection.sendToAsync(LogicalAddress::TV, MessageEncoder().encode(GiveDevicePowerStatus())));
+    }
+    for (size_t i = 0; i < frames.size(); i++) {
+        frames[i].wait();
+        maxUs = std::max(maxUs, frames[i].getCompletedTime() - frames[i].getQueuedTime());
+    }
+    sender.join();
+
+    printf("%-24s %4d frames, done after max %8llu us\n", "async frames", FRAMES, (unsigned long long)maxUs);
+}
+
+/* Time from the first to the last of a burst of held volume key repeats */
+static uint64_t volumeBurst(Connection &connection, int repeats)
+{
+    CECFrame pressed = MessageEncoder().encode(UserControlPressed(UICommand(UICommand::UI_COMMAND_VOLUME_UP)));
+    std::vector<TxCompletion> frames;
+
+    uint64_t start = GetMonotonicTimeUs();
+    for (int i = 0; i < repeats; i++) {
+        frames.push_back(connection.sendToAsync(LogicalAddress::AUDIO_SYSTEM, pressed, TX_PRIORITY_INTERACTIVE));
+    }
+    frames.push_back(connection.sendToAsync(LogicalAddress::AUDIO_SYSTEM, MessageEncoder().encode(UserControlReleased()), TX_PRIORITY_INTERACTIVE));
+    frames.back().wait();
+
+    return GetMonotonicTimeUs() - start;
+}
+
+static void benchCoalescing(Connection &connection)
+{
+    const int REPEATS = 20;
+
+    printf("== %d volume key repeats then release, time to the release ==\n", REPEATS);
+
+    uint64_t queued = volumeBurst(connection, REPEATS);
+    LibCCEC::getInstance().setTxCoalescing(true);
+    uint64_t coalesced = volumeBurst(connection, REPEATS);
+    LibCCEC::getInstance().setTxCoalescing(false);
+
+    printf("%-24s %8llu us\n", "every repeat sent", (unsigned long long)queued);
+    printf("%-24s %8llu us\n", "repeats coalesced", (unsigned long long)coalesced);
+}
+
+static uint64_t maxCompletionUs(std::vector<TxCompletion> &frames)
+{
+    uint64_t maxUs = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        frames[i].wait();
+        maxUs = std::max(maxUs, frames[i].getCompletedTime() - frames[i].getQueuedTime());
+    }
+    return maxUs;
+}
+
+static void benchHeadOfLine(Connection &connection)
+{
+    const int ABSENT = 20;
+    const int PRESENT = 10;
+    CECFrame request = MessageEncoder().encode(GiveDevicePowerStatus());
+    std::vector<TxCompletion> absent, present;
+
+    printf("== %d frames to an absent device queued ahead of %d to the TV ==\n", ABSENT, PRESENT);
+
+    for (int i = 0; i < ABSENT; i++) {
+        absent.push_back(connection.sendToAsync(LogicalAddress::SPECIFIC_USE, request));
+    }
+    for (int i = 0; i < PRESENT; i++) {
+        present.push_back(connection.sendToAsync(LogicalAddress::TV, request));
+    }
+
+    printf("%-24s done after max %8llu us\n", "TV", (unsigned long long)maxCompletionUs(present));
+    printf("%-24s done after max %8llu us\n", "absent device", (unsigned long long)maxCompletionUs(absent));
+}
+
+int main(int argc, char *argv[])
+{
+    benchFrames();
+    benchEncode();
+    benchResponseCache();
+    benchDecode();
+
+    if (argc > 1 && strcmp(argv[1], "bus") == 0) {
+        LibCCEC::getInstance().init("CECBenchmark");
+        Connection connection(LogicalAddress::PLAYBACK_DEVICE_1, false, "CECBenchmark");
+        connection.open();
+
+        benchScan(connection);
+        benchTxPriority(connection);
+        benchRetry(connection);
+        benchCoalescing(connection);
+        benchHeadOfLine(connection);
+
+        connection.close();
+        LibCCEC::getInstance().term();
+    }
+    return 0;
+}
+
+
+/** @} */
+/** @} */
@@ -0,0 +1,168 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup tests
+* @{
+**/
+
+
+#include <stdio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ccec/Messages.hpp"
+#include "ccec/MessageEncoder.hpp"
+#include "ccec/Connection.hpp"
+#include "ccec/FrameListener.hpp"
+#include "ccec/LibCCEC.hpp"
+#include "ccec/Util.hpp"
+#include "LoopbackHal.hpp"
+
+/*
+ * Measures how long a received frame waits before it is delivered while
+ * synchronous transmits are in flight. Runs against LoopbackHal, no CEC bus
+ * needed.
+ *
+ * A <Report Power Status> from the TV is handed to the library through the HAL
+ * receive callback, and the time from the callback to the delivery to a
+ * FrameListener is taken, first on a quiet bus and then while another thread
+ * floods the bus with synchronous sends that each hold the HAL for a frame
+ * time. With transmit and receive decoupled both figures should be close. The
+ * share of it spent in the receive ring, from RxStats, is reported alongside.
+ */
+
+static const int PROBES = 100;
+static const int REPLY_TIMEOUT_US = 1000000;
+/* About a two byte frame on the wire */
+static const int FRAME_TIME_US = 25 * 1000;
+
+class PowerStatusListener : public FrameListener {
+public:
+    PowerStatusListener(void) : arrived(0) {}
+
+    void notify(const CECFrame &frame) const {
+        if (frame.length() >= 2 && frame.at(1) == REPORT_POWER_STATUS &&
+            ((frame.at(0) >> 4) & 0x0F) == LogicalAddress::TV) {
+            arrived.store(GetMonotonicTimeUs());
+        }
+    }
+
+    mutable std::atomic<uint64_t> arrived;
+};
+
+static void probe(PowerStatusListener &listener, std::vector<int64_t> &latencies, RxStats &rxStats)
+{
+    /* TV to Playback Device 1: <Report Power Status> on */
+    const uint8_t reply[] = {0x04, REPORT_POWER_STATUS, PowerStatus::ON};
+    RxStats before;
+
+    LibCCEC::getInstance().getRxStats(before);
+
+    for (int i = 0; i < PROBES; i++) {
+        listener.arrived.store(0);
+
+        uint64_t received = GetMonotonicTimeUs();
+        LoopbackHal::getInstance().receive(reply, sizeof(reply));
+
+        while (listener.arrived.load() == 0 && GetMonotonicTimeUs() - received < (uint64_t)REPLY_TIMEOUT_US) {
+            usleep(100);
+        }
+
+        uint64_t arrived = listener.arrived.load();
+        if (arrived != 0) {
+            latencies.push_back((int64_t)(arrived - received));
+        }
+        usleep(5 * 1000);
+    }
+
+    LibCCEC::getInstance().getRxStats(rxStats);
+    rxStats.frames -= before.frames;
+    rxStats.dropped -= before.dropped;
+    rxStats.totalLatencyUs -= before.totalLatencyUs;
+}
+
+static void report(const char *name, std::vector<int64_t> &latencies, const RxStats &rxStats)
+{
+    if (latencies.empty()) {
+        printf("%-24s no frames delivered\n", name);
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    printf("%-24s %3zu frames  p50 %6lld us  p99 %6lld us  max %6lld us  in ring avg %6.1f us, %u dropped\n",
+           name, latencies.size(),
+           (long long)latencies[latencies.size() / 2],
+           (long long)latencies[(latencies.size() * 99) / 100],
+           (long long)latencies.back(),
+           rxStats.frames ? (double)rxStats.totalLatencyUs / rxStats.frames : 0.0, rxStats.dropped);
+}
+
+int main(int argc, char *argv[])
+{
+    LogicalAddress source(LogicalAddress::PLAYBACK_DEVICE_1);
+
+    LibCCEC::getInstance().init("CECLatencyTest");
+    LoopbackHal::getInstance().setTxTime(FRAME_TIME_US);
+
+    Connection connection(source, false, "CECLatencyTest");
+    PowerStatusListener listener;
+    connection.open();
+    connection.addFrameListener(&listener);
+
+    std::vector<int64_t> quiet, flooded;
+    RxStats quietStats, floodedStats;
+
+    probe(listener, quiet, quietStats);
+
+    std::atomic<bool> flooding(true);
+    std::thread flooder([&source, &flooding]() {
+        Connection sender(source, false, "CECLatencyTest flooder");
+        CECFrame request = MessageEncoder().encode(GiveDevicePowerStatus());
+        sender.open();
+        while (flooding.load()) {
+            sender.trySendTo(LogicalAddress::TV, request);
+        }
+        sender.close();
+    });
+
+    probe(listener, flooded, floodedStats);
+
+    flooding.store(false);
+    flooder.join();
+
+    report("quiet bus", quiet, quietStats);
+    report("flooded with sync sends", flooded, floodedStats);
+
+    connection.removeFrameListener(&listener);
+    connection.close();
+    LibCCEC::getInstance().term();
+
+    return (quiet.size() == PROBES && flooded.size() == PROBES) ? 0 : 1;
+}
+
+
+/** @} */
+/** @} */
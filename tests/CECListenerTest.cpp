@@ -0,0 +1,120 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup tests
+* @{
+**/
+
+
+#include <stdio.h>
+#include <unistd.h>
+#include <atomic>
+
+#include "ccec/Connection.hpp"
+#include "ccec/FrameListener.hpp"
+#include "ccec/LibCCEC.hpp"
+#include "ccec/Util.hpp"
+#include "LoopbackHal.hpp"
+
+/*
+ * Checks that closing a connection while the reader is dispatching a frame to
+ * a slow listener of another connection waits for the dispatch to end, and that
+ * the closed connection is not notified of that frame. Runs against
+ * LoopbackHal, no CEC bus needed.
+ */
+
+static const int SLOW_LISTENER_US = 200 * 1000;
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", what);
+    if (!ok) failures++;
+}
+
+class SlowListener : public FrameListener {
+public:
+    SlowListener(void) : started(0), finished(0) {}
+
+    void notify(const CECFrame &frame) const {
+        started.store(GetMonotonicTimeUs());
+        usleep(SLOW_LISTENER_US);
+        finished.store(GetMonotonicTimeUs());
+    }
+
+    mutable std::atomic<uint64_t> started;
+    mutable std::atomic<uint64_t> finished;
+};
+
+class CountingListener : public FrameListener {
+public:
+    CountingListener(void) : frames(0) {}
+
+    void notify(const CECFrame &frame) const {
+        frames++;
+    }
+
+    mutable std::atomic<int> frames;
+};
+
+int main(int argc, char *argv[])
+{
+    /* <Active Source> broadcast by the TV */
+    const uint8_t activeSource[] = {0x0F, 0x82, 0x00, 0x00};
+    SlowListener slow;
+    CountingListener counting;
+
+    LibCCEC::getInstance().init("CECListenerTest");
+    Connection slowConnection(LogicalAddress::UNREGISTERED, false, "CECListenerTest slow");
+    Connection otherConnection(LogicalAddress::UNREGISTERED, false, "CECListenerTest other");
+    slowConnection.open();
+    otherConnection.open();
+    slowConnection.addFrameListener(&slow);
+    otherConnection.addFrameListener(&counting);
+
+    LoopbackHal::getInstance().receive(activeSource, sizeof(activeSource));
+    while (slow.started.load() == 0) {
+        usleep(1000);
+    }
+
+    /* The slow listener was added first, so the other connection is still to be notified */
+    otherConnection.close();
+    uint64_t closedUs = GetMonotonicTimeUs();
+
+    check(slow.finished.load() != 0 && closedUs >= slow.finished.load(), "close waits for the dispatch in progress");
+    check(counting.frames.load() == 0, "the closed connection is not notified of that frame");
+    printf("close returned %llu us after the slow listener\n", (unsigned long long)(closedUs - slow.finished.load()));
+
+    LoopbackHal::getInstance().receive(activeSource, sizeof(activeSource));
+    usleep(2 * SLOW_LISTENER_US);
+    check(counting.frames.load() == 0, "the closed connection is not notified of later frames");
+
+    slowConnection.close();
+    LibCCEC::getInstance().term();
+    return failures;
+}
+
+
+/** @} */
+/** @} */
@@ -0,0 +1,106 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup tests
+* @{
+**/
+
+
+#include <stdio.h>
+
+#include "ccec/CECFrame.hpp"
+#include "ccec/Messages.hpp"
+#include "ccec/MessageEncoder.hpp"
+#include "ccec/ResponseCache.hpp"
+
+/*
+ * Checks that the response cache never serves a reply encoded from host state
+ * that has changed since. Does not touch the CEC bus.
+ */
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", what);
+    if (!ok) failures++;
+}
+
+static int powerStateCalls = 0;
+
+static CECHost_Err_t countPowerState(int32_t curState, int32_t newState)
+{
+    powerStateCalls++;
+    return CECHost_ERR_NONE;
+}
+
+static CECFrame powerStatus(int status)
+{
+    return MessageEncoder::encode(Header(LogicalAddress(LogicalAddress::TUNER_1), LogicalAddress(LogicalAddress::TV)),
+                                  ReportPowerStatus(PowerStatus(status)));
+}
+
+int main(int argc, char *argv[])
+{
+    LogicalAddress from(LogicalAddress::TUNER_1);
+    LogicalAddress to(LogicalAddress::TV);
+    ResponseCache &cache = ResponseCache::getInstance();
+    CECFrame frame;
+
+    CECHost_Callback_t callbacks = {0};
+    callbacks.pwrStateCb = countPowerState;
+    CECHost_Callback_t chained = ResponseCache::chainHostCallbacks(callbacks);
+
+    uint32_t generation = cache.getGeneration(REPORT_POWER_STATUS);
+    check(cache.put(powerStatus(PowerStatus::STANDBY), generation), "put stores a reply");
+    check(cache.get(REPORT_POWER_STATUS, from, to, frame) && frame.at(2) == PowerStatus::STANDBY, "get serves it");
+    check(!cache.get(REPORT_POWER_STATUS, LogicalAddress(LogicalAddress::TUNER_2), to, frame),
+          "get misses for another initiator");
+
+    chained.pwrStateCb(PowerStatus::STANDBY, PowerStatus::ON);
+    check(powerStateCalls == 1, "power state hook calls the chained callback");
+    check(!cache.get(REPORT_POWER_STATUS, from, to, frame), "power state change drops the reply");
+
+    /* Encoded while in standby, put after the change to on */
+    generation = cache.getGeneration(REPORT_POWER_STATUS);
+    CECFrame stale = powerStatus(PowerStatus::STANDBY);
+    chained.pwrStateCb(PowerStatus::STANDBY, PowerStatus::ON);
+    check(!cache.put(stale, generation), "put refuses a reply encoded before the change");
+    check(!cache.get(REPORT_POWER_STATUS, from, to, frame), "the stale reply is not served");
+
+    generation = cache.getGeneration(REPORT_POWER_STATUS);
+    check(cache.put(powerStatus(PowerStatus::ON), generation), "put stores a reply encoded after the change");
+    check(cache.get(REPORT_POWER_STATUS, from, to, frame) && frame.at(2) == PowerStatus::ON, "get serves the new reply");
+
+    generation = cache.getGeneration(SET_OSD_NAME);
+    cache.invalidate(REPORT_POWER_STATUS);
+    check(cache.getGeneration(SET_OSD_NAME) == generation, "invalidation leaves other opcodes alone");
+    chained.hotplugCb(1);
+    check(cache.getGeneration(SET_OSD_NAME) != generation, "hotplug invalidates every opcode");
+
+    return failures;
+}
+
+
+/** @} */
+/** @} */
@@ -0,0 +1,182 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup tests
+* @{
+**/
+
+
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ccec/Util.hpp"
+
+#include "ccec/Messages.hpp"
+#include "ccec/MessageEncoder.hpp"
+#include "ccec/Connection.hpp"
+#include "ccec/LibCCEC.hpp"
+#include "LoopbackHal.hpp"
+
+/*
+ * Checks the order in which the Bus writer puts frames on the wire when one of
+ * them is NACKed and retried, how long frames wait for a device that keeps
+ * NACKing, and where frames replaced in the queue are completed. Runs against
+ * LoopbackHal, no CEC bus needed.
+ */
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", what);
+    if (!ok) failures++;
+}
+
+static bool isMessage(const CECFrame &frame, int to, Op_t opCode)
+{
+    return frame.length() >= 2 && (frame.at(0) & 0x0F) == to && frame.at(1) == opCode;
+}
+
+static void testRetryOrder(Connection &connection)
+{
+    LoopbackHal &hal = LoopbackHal::getInstance();
+    TxRetryPolicy retry(3, 50);
+
+    hal.setPresent((1 << LogicalAddress::TV) | (1 << LogicalAddress::AUDIO_SYSTEM));
+    hal.nack(LogicalAddress::AUDIO_SYSTEM, 1);
+    hal.clearSent();
+
+    TxCompletion pressed = connection.sendToAsync(LogicalAddress::AUDIO_SYSTEM,
+        MessageEncoder().encode(UserControlPressed(UICommand(UICommand::UI_COMMAND_VOLUME_UP))), TX_PRIORITY_INTERACTIVE, NULL, retry);
+    TxCompletion released = connection.sendToAsync(LogicalAddress::AUDIO_SYSTEM,
+        MessageEncoder().encode(UserControlReleased()), TX_PRIORITY_INTERACTIVE, NULL, retry);
+    TxCompletion other = connection.sendToAsync(LogicalAddress::TV,
+        MessageEncoder().encode(UserControlReleased()), TX_PRIORITY_INTERACTIVE, NULL, retry);
+
+    check(pressed.wait() == SEND_ACKED && pressed.getAttempts() == 2, "the press is ACKed on its second attempt");
+    check(released.wait() == SEND_ACKED && released.getAttempts() == 1, "the release is ACKed on its first attempt");
+    check(other.wait() == SEND_ACKED, "the frame to the TV is ACKed");
+
+    /* Frames to the audio system in wire order, and where the frame to the TV went */
+    std::vector<CECFrame> sent = hal.getSent();
+    std::vector<CECFrame> audio;
+    size_t tv = sent.size();
+    for (size_t i = 0; i < sent.size(); i++) {
+        if ((sent[i].at(0) & 0x0F) == LogicalAddress::AUDIO_SYSTEM) {
+            audio.push_back(sent[i]);
+        }
+        else if (isMessage(sent[i], LogicalAddress::TV, USER_CONTROL_RELEASED)) {
+            tv = audio.size();
+        }
+    }
+
+    check(sent.size() == 4 && audio.size() == 3, "four frames on the wire, three to the audio system");
+    if (audio.size() != 3) {
+        return;
+    }
+    check(isMessage(audio[0], LogicalAddress::AUDIO_SYSTEM, USER_CONTROL_PRESSED), "the press goes first and is NACKed");
+    check(isMessage(audio[1], LogicalAddress::AUDIO_SYSTEM, USER_CONTROL_PRESSED), "the press is retried");
+    check(isMessage(audio[2], LogicalAddress::AUDIO_SYSTEM, USER_CONTROL_RELEASED), "the release follows the retried press");
+    check(tv < 2, "the TV is served while the press waits for its retry");
+}
+
+static void testBackoffDeadline(Connection &connection)
+{
+    CECFrame request = MessageEncoder().encode(GiveDevicePowerStatus());
+
+    /* Enough NACKs to back the absent device off for the longest time */
+    for (int i = 0; i < 6; i++) {
+        connection.sendToAsync(LogicalAddress::SPECIFIC_USE, request).wait();
+    }
+
+    TxCompletion background = connection.sendToAsync(LogicalAddress::SPECIFIC_USE, request);
+    uint64_t start = GetMonotonicTimeUs();
+    SendResult result = connection.trySendTo(LogicalAddress::SPECIFIC_USE, request, 100);
+    uint64_t elapsedUs = GetMonotonicTimeUs() - start;
+
+    check(result != SEND_ACKED && elapsedUs < 250 * 1000, "a sync send with a 100 ms timeout is not held back by the back off");
+    check(!background.isDone(), "a frame without a deadline still waits for the back off");
+    background.wait();
+}
+
+class ThreadListener : public TxCompletionListener {
+public:
+    ThreadListener(void) : superseded(0), onCaller(0), caller(std::this_thread::get_id()) {}
+
+    void onTxCompleted(const TxCompletion &completion) {
+        if (completion.getResult() == SEND_SUPERSEDED) {
+            superseded++;
+        }
+        if (std::this_thread::get_id() == caller) {
+            onCaller++;
+        }
+    }
+
+    std::atomic<int> superseded;
+    std::atomic<int> onCaller;
+    std::thread::id caller;
+};
+
+static void testSupersededListener(Connection &connection)
+{
+    LoopbackHal &hal = LoopbackHal::getInstance();
+    CECFrame pressed = MessageEncoder().encode(UserControlPressed(UICommand(UICommand::UI_COMMAND_VOLUME_UP)));
+    ThreadListener listener;
+    std::vector<TxCompletion> frames;
+
+    /* The first repeat keeps the writer busy while the others are coalesced behind it */
+    hal.setTxTime(50 * 1000);
+    LibCCEC::getInstance().setTxCoalescing(true);
+    for (int i = 0; i < 4; i++) {
+        frames.push_back(connection.sendToAsync(LogicalAddress::AUDIO_SYSTEM, pressed, TX_PRIORITY_INTERACTIVE, &listener));
+    }
+    for (size_t i = 0; i < frames.size(); i++) {
+        frames[i].wait();
+    }
+    LibCCEC::getInstance().setTxCoalescing(false);
+    hal.setTxTime(0);
+
+    check(listener.superseded > 0, "repeats are superseded");
+    check(listener.onCaller == 0, "superseded frames complete on the writer thread");
+}
+
+int main(int argc, char *argv[])
+{
+    LibCCEC::getInstance().init("CECTxOrderTest");
+    Connection connection(LogicalAddress::PLAYBACK_DEVICE_1, false, "CECTxOrderTest");
+    connection.open();
+
+    testRetryOrder(connection);
+    testBackoffDeadline(connection);
+    testSupersededListener(connection);
+
+    connection.close();
+    LibCCEC::getInstance().term();
+    return failures;
+}
+
+
+/** @} */
+/** @} */
@@ -0,0 +1,201 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2016 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+
+/**
+* @defgroup hdmicec
+* @{
+* @defgroup tests
+* @{
+**/
+
+
+#ifndef HDMI_CCEC_TESTS_LOOPBACK_HAL_HPP_
+#define HDMI_CCEC_TESTS_LOOPBACK_HAL_HPP_
+
+#include <stdint.h>
+#include <unistd.h>
+#include <mutex>
+#include <vector>
+
+#include "ccec/CECFrame.hpp"
+#include "ccec/drivers/hdmi_cec_driver.h"
+
+/*
+ * Stand-in for the platform CEC HAL, for tests that run without a CEC bus.
+ * libRCEC leaves the HAL to the program, so a test that includes this header
+ * (in one source file) runs the whole library against it.
+ *
+ * Every transmitted frame is recorded, in the order it reached the "wire".
+ * Frames to the devices marked present are ACKed, broadcasts always are, and
+ * the rest are NACKed. receive() hands a frame to the library as if the HAL
+ * had received it, on the calling thread.
+ */
+class LoopbackHal {
+public:
+    static LoopbackHal & getInstance(void)
+    {
+        static LoopbackHal instance;
+        return instance;
+    }
+
+    /* One bit per logical address */
+    void setPresent(uint16_t mask)
+    {
+        std::lock_guard<std::mutex> lock_(mutex);
+        present = mask;
+    }
+
+    /* NACKs the next count frames to destination, even if it is present */
+    void nack(int destination, int count)
+    {
+        std::lock_guard<std::mutex> lock_(mutex);
+        nacks[destination & 0x0F] = count;
+    }
+
+    /* Time each transmit takes, in microseconds */
+    void setTxTime(int us)
+    {
+        std::lock_guard<std::mutex> lock_(mutex);
+        txTimeUs = us;
+    }
+
+    std::vector<CECFrame> getSent(void)
+    {
+        std::lock_guard<std::mutex> lock_(mutex);
+        return sent;
+    }
+
+    void clearSent(void)
+    {
+        std::lock_guard<std::mutex> lock_(mutex);
+        sent.clear();
+    }
+
+    void receive(const uint8_t *buf, int len)
+    {
+        HdmiCecRxCallback_t callback = rxCallback;
+        if (callback != NULL) {
+            callback(1, rxData, (unsigned char *)buf, len);
+        }
+    }
+
+    int transmit(const unsigned char *buf, int len)
+    {
+        int destination = buf[0] & 0x0F;
+        int txTime;
+        bool acked;
+
+        {std::lock_guard<std::mutex> lock_(mutex);
+            sent.push_back(CECFrame(buf, len));
+            acked = (destination == 0x0F) || (((present >> destination) & 1) && nacks[destination] == 0);
+            if (nacks[destination] > 0) {
+                nacks[destination]--;
+            }
+            txTime = txTimeUs;
+        }
+
+        if (txTime > 0) {
+            usleep(txTime);
+        }
+        return acked ? HDMI_CEC_IO_SENT_AND_ACKD : HDMI_CEC_IO_SENT_BUT_NOT_ACKD;
+    }
+
+    volatile HdmiCecRxCallback_t rxCallback;
+    void *rxData;
+
+private:
+    LoopbackHal(void) : rxCallback(NULL), rxData(NULL), present(1 << 0), txTimeUs(0)
+    {
+        for (int i = 0; i < 16; i++) nacks[i] = 0;
+    }
+
+    std::mutex mutex;
+    uint16_t present;
+    int nacks[16];
+    int txTimeUs;
+    std::vector<CECFrame> sent;
+};
+
+extern "C" {
+
+int HdmiCecOpen(int *handle)
+{
+    *handle = 1;
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+int HdmiCecClose(int handle)
+{
+    LoopbackHal::getInstance().rxCallback = NULL;
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+int HdmiCecSetRxCallback(int handle, HdmiCecRxCallback_t cbfunc, void *data)
+{
+    LoopbackHal::getInstance().rxData = data;
+    LoopbackHal::getInstance().rxCallback = cbfunc;
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+int HdmiCecSetTxCallback(int handle, HdmiCecTxCallback_t cbfunc, void *data)
+{
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+int HdmiCecTx(int handle, const unsigned char *buf, int len, int *result)
+{
+    *result = LoopbackHal::getInstance().transmit(buf, len);
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+int HdmiCecTxAsync(int handle, const unsigned char *buf, int len)
+{
+    (void) LoopbackHal::getInstance().transmit(buf, len);
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+int HdmiCecGetLogicalAddress(int handle, int *logicalAddresses)
+{
+    *logicalAddresses = 3;
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+void HdmiCecGetPhysicalAddress(int handle, unsigned int *physicalAddress)
+{
+    *physicalAddress = 0x1000;
+}
+
+int HdmiCecAddLogicalAddress(int handle, int logicalAddresses)
+{
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+int HdmiCecRemoveLogicalAddress(int handle, int logicalAddresses)
+{
+    return HDMI_CEC_IO_SUCCESS;
+}
+
+}
+
+#endif
+
+
+/** @} */
+/** @} */